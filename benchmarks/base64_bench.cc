@@ -0,0 +1,163 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "encoding.h"
+
+/**
+ * The codec shipped before the SIMD rewrite, kept here as the baseline every change is measured against.
+ */
+namespace Legacy
+{
+    static std::string Base64Decode(const std::string &in) 
+    {
+        std::string out;
+        std::vector<int> T(256,-1);
+        for (int i=0; i<64; i++) T["ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[i]] = i;
+
+        int val=0, valb=-8;
+        for (unsigned char c : in) 
+        {
+            if (T[c] == -1) break;
+            val = (val << 6) + T[c];
+            valb += 6;
+            if (valb >= 0) 
+            {
+                out.push_back(char((val>>valb)&0xFF));
+                valb -= 8;
+            }
+        }
+        return out;
+    }
+
+    static std::string Base64Encode(const std::string &in) 
+    {
+        std::string out;
+
+        int val = 0, valb = -6;
+        for (unsigned char c : in) 
+        {
+            val = (val << 8) + c;
+            valb += 8;
+            while (valb >= 0) 
+            {
+                out.push_back("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(val>>valb)&0x3F]);
+                valb -= 6;
+            }
+        }
+        if (valb>-6) out.push_back("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[((val<<8)>>(valb+8))&0x3F]);
+        while (out.size()%4) out.push_back('=');
+        return out;
+    }
+}
+
+static std::string RandomBytes(size_t length)
+{
+    std::mt19937 generator(1337);
+    std::string bytes(length, '\0');
+
+    for (auto& byte : bytes) byte = static_cast<char>(generator());
+    return bytes;
+}
+
+static void BM_Base64Encode_Legacy(benchmark::State& state)
+{
+    const std::string input = RandomBytes(state.range(0));
+
+    for (auto _ : state) benchmark::DoNotOptimize(Legacy::Base64Encode(input));
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+static void BM_Base64Encode(benchmark::State& state)
+{
+    const std::string input = RandomBytes(state.range(0));
+
+    for (auto _ : state) benchmark::DoNotOptimize(Base64Encode(input));
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.SetLabel(Base64::GetKernelName());
+}
+
+static void BM_Base64EncodeInto(benchmark::State& state)
+{
+    const std::string input = RandomBytes(state.range(0));
+    std::string output(Base64::EncodedLength(input.size()), '\0');
+
+    for (auto _ : state) 
+    {
+        benchmark::DoNotOptimize(Base64::EncodeInto(input.data(), input.size(), &output[0]));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.SetLabel(Base64::GetKernelName());
+}
+
+static void BM_Base64Decode_Legacy(benchmark::State& state)
+{
+    const std::string input = Base64Encode(RandomBytes(state.range(0)));
+
+    for (auto _ : state) benchmark::DoNotOptimize(Legacy::Base64Decode(input));
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+static void BM_Base64Decode(benchmark::State& state)
+{
+    const std::string input = Base64Encode(RandomBytes(state.range(0)));
+
+    for (auto _ : state) benchmark::DoNotOptimize(Base64Decode(input));
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.SetLabel(Base64::GetKernelName());
+}
+
+static void BM_Base64DecodeInto_Strict(benchmark::State& state)
+{
+    const std::string input = Base64Encode(RandomBytes(state.range(0)));
+    std::string output(Base64::MaxDecodedLength(input.size()), '\0');
+
+    for (auto _ : state) 
+    {
+        benchmark::DoNotOptimize(Base64::DecodeInto(input.data(), input.size(), &output[0], Base64::DecodeMode::Strict));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.SetLabel(Base64::GetKernelName());
+}
+
+/** 4 KiB (small assets), 256 KiB (typical documents), 4 MiB (library chunks) */
+#define BASE64_SIZES RangeMultiplier(64)->Range(4 << 10, 4 << 20)
+
+BENCHMARK(BM_Base64Encode_Legacy)->BASE64_SIZES;
+BENCHMARK(BM_Base64Encode)->BASE64_SIZES;
+BENCHMARK(BM_Base64EncodeInto)->BASE64_SIZES;
+BENCHMARK(BM_Base64Decode_Legacy)->BASE64_SIZES;
+BENCHMARK(BM_Base64Decode)->BASE64_SIZES;
+BENCHMARK(BM_Base64DecodeInto_Strict)->BASE64_SIZES;
@@ -0,0 +1,164 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <Python.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/**
+ * Cold start of a plugin backend: a fresh sub-interpreter imports a backend package of `count` modules, 
+ * once compiling every module from source (write_bytecode = 0, as before), once with an empty bytecode cache 
+ * (the first start after a plugin update) and once from a populated cache (every start after that).
+ */
+enum class BytecodeCache { Disabled, Cold, Warm };
+
+static const std::filesystem::path& GetScratchPath()
+{
+    static const std::filesystem::path scratchPath = []
+    {
+        const auto path = std::filesystem::temp_directory_path() / "millennium-benchmarks-bytecode";
+
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+        return path;
+    }();
+
+    return scratchPath;
+}
+
+/** About 200 lines per module, shaped like typical backend code (classes, dict literals, string formatting, imports). */
+static std::string CreateModuleSource(int64_t index)
+{
+    std::string source = "import json\nimport os\n\n";
+
+    for (int i = 0; i < 12; i++) 
+    {
+        const std::string name = "Handler" + std::to_string(index) + "_" + std::to_string(i);
+
+        source += "class " + name + ":\n"
+                  "    DEFAULTS = { 'enabled': True, 'retries': 3, 'timeout': 2.5, 'tags': ['theme', 'store'] }\n\n"
+                  "    def __init__(self, name, options=None):\n"
+                  "        self.name = name\n"
+                  "        self.options = { **self.DEFAULTS, **(options or {}) }\n\n"
+                  "    def describe(self):\n"
+                  "        return '%s(%s)' % (self.name, ', '.join('%s=%r' % item for item in sorted(self.options.items())))\n\n"
+                  "    def load(self, path):\n"
+                  "        if not os.path.exists(path):\n"
+                  "            return { 'name': self.name, 'error': 'missing %s' % path }\n"
+                  "        with open(path) as file:\n"
+                  "            return json.load(file)\n\n"
+                  "    def handle(self, request):\n"
+                  "        result = []\n"
+                  "        for key, value in request.items():\n"
+                  "            if isinstance(value, dict):\n"
+                  "                result.append((key, self.handle(value)))\n"
+                  "            elif key in self.options:\n"
+                  "                result.append((key, self.options[key]))\n"
+                  "        return dict(result)\n\n";
+    }
+    return source;
+}
+
+/** @returns {std::filesystem::path} - A directory holding the generated `backend` package, shared by all benchmarks of the same size. */
+static std::filesystem::path CreateBackend(int64_t count)
+{
+    const auto root = GetScratchPath() / ("backend-" + std::to_string(count));
+    const auto package = root / "backend";
+
+    if (!std::filesystem::exists(package)) 
+    {
+        std::filesystem::create_directories(package);
+        std::ofstream init(package / "__init__.py");
+
+        for (int64_t i = 0; i < count; i++) 
+        {
+            std::ofstream(package / ("module_" + std::to_string(i) + ".py")) << CreateModuleSource(i);
+            init << "from . import module_" << i << "\n";
+        }
+    }
+    return root;
+}
+
+static void BM_BackendColdStart(benchmark::State& state, BytecodeCache cache)
+{
+    if (!Py_IsInitialized()) 
+    {
+        Py_Initialize();
+    }
+
+    const auto backendPath = CreateBackend(state.range(0));
+    const auto cachePath = GetScratchPath() / ("pycache-" + std::to_string(state.range(0)));
+
+    std::filesystem::remove_all(cachePath);
+
+    /** The settings PythonManager passes through PyConfig, applied per sub-interpreter as importlib reads them from sys. */
+    const std::string setup = cache == BytecodeCache::Disabled
+        ? "import sys\nsys.dont_write_bytecode = True\nsys.pycache_prefix = None\n"
+        : "import sys\nsys.dont_write_bytecode = False\nsys.pycache_prefix = r'" + cachePath.string() + "'\n";
+
+    const std::string load = setup + "sys.path.insert(0, r'" + backendPath.string() + "')\nimport backend\n";
+
+    PyThreadState* mainThreadState = PyThreadState_Get();
+
+    /** Populates the cache the warm runs start from. */
+    if (cache == BytecodeCache::Warm) 
+    {
+        PyThreadState* interpreter = Py_NewInterpreter();
+        PyRun_SimpleString(load.c_str());
+        Py_EndInterpreter(interpreter);
+        PyThreadState_Swap(mainThreadState);
+    }
+
+    for (auto _ : state) 
+    {
+        if (cache == BytecodeCache::Cold) 
+        {
+            state.PauseTiming();
+            std::filesystem::remove_all(cachePath);
+            state.ResumeTiming();
+        }
+
+        PyThreadState* interpreter = Py_NewInterpreter();
+
+        if (PyRun_SimpleString(load.c_str()) != 0) 
+        {
+            state.SkipWithError("the backend failed to import");
+        }
+
+        Py_EndInterpreter(interpreter);
+        PyThreadState_Swap(mainThreadState);
+    }
+}
+
+BENCHMARK_CAPTURE(BM_BackendColdStart, no_cache,   BytecodeCache::Disabled)->Arg(16)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BackendColdStart, cold_cache, BytecodeCache::Cold)->Arg(16)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BackendColdStart, warm_cache, BytecodeCache::Warm)->Arg(16)->Arg(128)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,242 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <regex>
+#include <nlohmann/json.hpp>
+#include "bench_fixtures.h"
+#include "http_hooks.h"
+#include "locals.h"
+#include "ffi.h"
+#include "co_spawn.h"
+
+class HttpHookManagerBenchmark
+{
+public:
+    static std::string PatchDocumentContents(const std::string& requestUrl, const std::string& document)
+    {
+        return HttpHookManager::get().PatchDocumentContents(requestUrl, document, {}, true);
+    }
+};
+
+/**
+ * @brief Point the Millennium environment at the fixtures and a scratch directory, so nothing outside of it is read or written.
+ * @returns {std::filesystem::path} - The scratch directory, recreated once per process.
+ */
+static const std::filesystem::path& SetupEnvironment()
+{
+    static const std::filesystem::path scratchPath = []
+    {
+        const auto path = std::filesystem::temp_directory_path() / "millennium-benchmarks";
+
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+
+        setenv("MILLENNIUM__SHIMS_PATH",  BenchFixtures::GetFixturePath("shims").string().c_str(), 1);
+        setenv("MILLENNIUM__ASSETS_PATH", BenchFixtures::GetFixturePath("plugin").string().c_str(), 1);
+        setenv("MILLENNIUM__CONFIG_PATH", (path / "config").string().c_str(), 1);
+        setenv("MILLENNIUM__LOGS_PATH",   (path / "logs").string().c_str(), 1);
+        return path;
+    }();
+
+    return scratchPath;
+}
+
+/** 
+ * Half of the hooks are stylesheets (inlined into the document), half are modules (linked), 
+ * and every other pair targets a URL pattern the document doesn't match.
+ */
+static void BM_PatchDocumentContents(benchmark::State& state)
+{
+    SetupEnvironment();
+
+    const std::string document = BenchFixtures::ReadFixture("document.html");
+    auto hookList = std::make_shared<std::vector<HttpHookManager::HookType>>();
+
+    for (int64_t i = 0; i < state.range(0); i++) 
+    {
+        const bool isStylesheet = i % 2 == 0;
+
+        hookList->push_back({
+            BenchFixtures::GetFixturePath(isStylesheet ? "hooks/library.css" : "hooks/store.js").generic_string(),
+            std::regex(i % 4 < 2 ? ".*" : R"(https://store\.steampowered\.com/app/.*)"),
+            isStylesheet ? HttpHookManager::TagTypes::STYLESHEET : HttpHookManager::TagTypes::JAVASCRIPT,
+            static_cast<unsigned long long>(i)
+        });
+    }
+
+    HttpHookManager::get().SetHookList(hookList);
+
+    for (auto _ : state) 
+    {
+        benchmark::DoNotOptimize(HttpHookManagerBenchmark::PatchDocumentContents("https://store.steampowered.com/", document));
+    }
+
+    HttpHookManager::get().SetHookList(std::make_shared<std::vector<HttpHookManager::HookType>>());
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+
+static void BM_ReadJsonSync(benchmark::State& state)
+{
+    const std::string pluginConfiguration = BenchFixtures::GetFixturePath("plugin/plugin.json").string();
+
+    for (auto _ : state) 
+    {
+        benchmark::DoNotOptimize(SystemIO::ReadJsonSync(pluginConfiguration));
+    }
+}
+
+/**
+ * Lays out `count` copies of the fixture plugin in the scratch directory, each with a unique name.
+ */
+static std::filesystem::path CreatePluginsDirectory(int64_t count)
+{
+    const auto pluginsPath = SetupEnvironment() / ("plugins-" + std::to_string(count));
+    nlohmann::json pluginJson = nlohmann::json::parse(BenchFixtures::ReadFixture("plugin/plugin.json"));
+
+    for (int64_t i = 0; i < count; i++) 
+    {
+        const auto pluginPath = pluginsPath / ("benchmark-plugin-" + std::to_string(i));
+        std::filesystem::create_directories(pluginPath);
+
+        pluginJson["name"] = "benchmark-plugin-" + std::to_string(i);
+        std::ofstream(pluginPath / SettingsStore::pluginConfigFile) << pluginJson.dump(4);
+    }
+
+    return pluginsPath;
+}
+
+static void BM_ParseAllPlugins(benchmark::State& state)
+{
+    const auto pluginsPath = CreatePluginsDirectory(state.range(0));
+    setenv("MILLENNIUM__PLUGINS_PATH", pluginsPath.string().c_str(), 1);
+
+    SettingsStore settingsStore;
+
+    for (auto _ : state) 
+    {
+        benchmark::DoNotOptimize(settingsStore.ParseAllPlugins());
+    }
+}
+
+/** Argument 0 is a typical call (short string, bool, number), 1 passes the ~100 KiB document as a string argument. */
+static void BM_ConstructFunctionCall(benchmark::State& state)
+{
+    const std::string payload = state.range(0) ? BenchFixtures::ReadFixture("document.html") : "Updated \"Benchmark Plugin\" to v1.4.2";
+
+    const std::vector<JavaScript::JsFunctionConstructTypes> params = {
+        { payload, JavaScript::Types::String  },
+        { "True",  JavaScript::Types::Boolean },
+        { "42",    JavaScript::Types::Integer }
+    };
+
+    for (auto _ : state) 
+    {
+        benchmark::DoNotOptimize(JavaScript::ConstructFunctionCall("benchmark-plugin", "receive_update", params));
+    }
+}
+
+/**
+ * Log attribution, i.e the lookup done on every sys.stdout write, with N plugins loaded. 
+ * The interpreters are never dereferenced, so distinct fake addresses stand in for them.
+ */
+static std::vector<std::shared_ptr<PythonThreadState>> CreateInstances(int64_t count)
+{
+    std::vector<std::shared_ptr<PythonThreadState>> instances;
+
+    for (int64_t i = 0; i < count; i++) 
+    {
+        auto* fakeThread = reinterpret_cast<PyThreadState*>(static_cast<uintptr_t>(0x1000 + i * 0x100));
+        instances.push_back(std::make_shared<PythonThreadState>("plugin-" + std::to_string(i), fakeThread, std::make_shared<InterpreterMutex>()));
+    }
+    return instances;
+}
+
+static PyInterpreterState* FakeInterpreter(const std::shared_ptr<PythonThreadState>& instance)
+{
+    return reinterpret_cast<PyInterpreterState*>(instance->thread_state);
+}
+
+static void BM_PluginNameFromInterpreter_Legacy(benchmark::State& state)
+{
+    const auto instances = CreateInstances(state.range(0));
+    std::mutex instancesMutex;
+    PyThreadState* target = instances.back()->thread_state;
+
+    for (auto _ : state) 
+    {
+        std::vector<std::shared_ptr<PythonThreadState>> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(instancesMutex);
+            snapshot = instances;
+        }
+
+        std::string pluginName;
+        for (const auto& instance : snapshot) 
+        {
+            if (instance->thread_state == target) 
+            {
+                pluginName = instance->pluginName;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(pluginName);
+    }
+}
+
+static void BM_PluginNameFromInterpreter(benchmark::State& state)
+{
+    const auto instances = CreateInstances(state.range(0));
+    PythonInstanceRegistry registry;
+
+    for (const auto& instance : instances) 
+    {
+        registry.Add(instance, FakeInterpreter(instance));
+    }
+
+    PyInterpreterState* target = FakeInterpreter(instances.back());
+
+    for (auto _ : state) 
+    {
+        auto instance = registry.FindByInterpreter(target);
+        benchmark::DoNotOptimize(instance != nullptr ? instance->pluginName : std::string());
+    }
+}
+
+BENCHMARK(BM_PatchDocumentContents)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(BM_ReadJsonSync);
+BENCHMARK(BM_ParseAllPlugins)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(BM_ConstructFunctionCall)->Arg(0)->Arg(1);
+BENCHMARK(BM_PluginNameFromInterpreter_Legacy)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(BM_PluginNameFromInterpreter)->Arg(1)->Arg(16)->Arg(128);
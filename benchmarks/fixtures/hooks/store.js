@@ -0,0 +1,8 @@
+import { callable } from "./millennium-api.js";
+
+const getPrices = callable("get_prices");
+
+export default async function main() {
+    const prices = await getPrices({ appIds: [...document.querySelectorAll("[data-ds-appid]")].map((node) => node.dataset.dsAppid) });
+    console.log("received", prices.length, "prices");
+}
@@ -0,0 +1,2 @@
+// Stand-in for the webkit preload module, PatchDocumentContents only checks that it exists.
+export default class { StartPreloader() {} }
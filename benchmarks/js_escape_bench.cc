@@ -0,0 +1,115 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include "js_escape.h"
+#include "bench_fixtures.h"
+
+/**
+ * The stream based escaper shipped before the SIMD scanned rewrite, kept as the baseline.
+ */
+namespace Legacy
+{
+    static std::string EscapeJavaScriptString(const std::string& input)
+    {
+        std::ostringstream escaped;
+        escaped << std::hex;
+
+        for (unsigned char c : input) 
+        {
+            switch (c) 
+            {
+                case '\"': escaped << "\\\""; break;
+                case '\\': escaped << "\\\\"; break;
+                case '\b': escaped << "\\b";  break;
+                case '\f': escaped << "\\f";  break;
+                case '\n': escaped << "\\n";  break;
+                case '\r': escaped << "\\r";  break;
+                case '\t': escaped << "\\t";  break;
+
+                default:
+                    if (c < 0x20) 
+                    {
+                        escaped << "\\u" << std::uppercase << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+                    } 
+                    else 
+                    {
+                        escaped << c;
+                    }
+                    break;
+            }
+        }
+
+        return escaped.str();
+    }
+}
+
+/** Argument 0 escapes a short call argument, 1 a ~100 KiB document passed to the frontend as a string. */
+static std::string GetInput(const benchmark::State& state)
+{
+    return state.range(0) ? BenchFixtures::ReadFixture("document.html") : "Successfully updated \"Benchmark Plugin\" to v1.4.2";
+}
+
+static void BM_EscapeJavaScriptString_Legacy(benchmark::State& state)
+{
+    const std::string input = GetInput(state);
+
+    for (auto _ : state) benchmark::DoNotOptimize(Legacy::EscapeJavaScriptString(input));
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+static void BM_EscapeString(benchmark::State& state)
+{
+    const std::string input = GetInput(state);
+
+    for (auto _ : state) benchmark::DoNotOptimize(JavaScript::EscapeString(input));
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+static void BM_EscapeStringInto_Json(benchmark::State& state)
+{
+    const std::string input = GetInput(state);
+    std::string output;
+
+    for (auto _ : state) 
+    {
+        output.clear();
+        JavaScript::EscapeStringInto(input, output, JavaScript::EscapeContext::Json);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(BM_EscapeJavaScriptString_Legacy)->Arg(0)->Arg(1);
+BENCHMARK(BM_EscapeString)->Arg(0)->Arg(1);
+BENCHMARK(BM_EscapeStringInto_Json)->Arg(0)->Arg(1);
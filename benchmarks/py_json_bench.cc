@@ -0,0 +1,143 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <Python.h>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "ffi.h"
+
+/**
+ * The conversions used before the native converter, a round trip through the json module and nlohmann's parser.
+ */
+namespace Legacy
+{
+    static nlohmann::json PyObjectToJson(PyObject* object)
+    {
+        PyObject* jsonModule = PyImport_ImportModule("json");
+        PyObject* encoded = PyObject_CallMethod(jsonModule, "dumps", "O", object);
+
+        nlohmann::json value = nlohmann::json::parse(PyUnicode_AsUTF8(encoded));
+
+        Py_DECREF(encoded);
+        Py_DECREF(jsonModule);
+        return value;
+    }
+
+    static PyObject* JsonToPyObject(const nlohmann::json& value)
+    {
+        PyObject* jsonModule = PyImport_ImportModule("json");
+        PyObject* decoded = PyObject_CallMethod(jsonModule, "loads", "s", value.dump().c_str());
+
+        Py_DECREF(jsonModule);
+        return decoded;
+    }
+}
+
+/**
+ * @brief Build a Python value from an expression, in a process wide interpreter that is started on first use.
+ */
+static PyObject* EvaluatePython(const std::string& setup, const char* expression)
+{
+    static PyObject* globals = []
+    {
+        Py_Initialize();
+
+        PyObject* dict = PyDict_New();
+        PyDict_SetItemString(dict, "__builtins__", PyEval_GetBuiltins());
+        return dict;
+    }();
+
+    PyObject* result = PyRun_String(setup.c_str(), Py_file_input, globals, globals);
+    Py_XDECREF(result);
+
+    return PyRun_String(expression, Py_eval_input, globals, globals);
+}
+
+/** A list of `count` records shaped like a typical IPC payload. */
+static PyObject* CreatePayload(int64_t count)
+{
+    return EvaluatePython(
+        "count = " + std::to_string(count), 
+        "[{ 'id': i, 'name': 'plugin-%d' % i, 'tags': ['theme', 'store'], 'score': i * 0.5, 'enabled': i % 2 == 0, 'parent': None } for i in range(count)]"
+    );
+}
+
+/** Lists nested `depth` levels deep, close to the converters' limit at the largest argument. */
+static PyObject* CreateNestedPayload(int64_t depth)
+{
+    return EvaluatePython("nested = 'leaf'\nfor _ in range(" + std::to_string(depth) + "): nested = [nested, { 'depth': _ }]", "nested");
+}
+
+/** Correctness of the native converters is covered by tests/py_json_test.cc, these only time them. */
+static void BM_PyObjectToJson(benchmark::State& state, PyObject* (*createPayload)(int64_t), bool legacy)
+{
+    PyObject* payload = createPayload(state.range(0));
+
+    for (auto _ : state) 
+    {
+        if (legacy) 
+        {
+            benchmark::DoNotOptimize(Legacy::PyObjectToJson(payload));
+        }
+        else 
+        {
+            nlohmann::json converted;
+            benchmark::DoNotOptimize(Python::PyObjectToJson(payload, converted));
+        }
+    }
+
+    Py_DECREF(payload);
+}
+
+static void BM_JsonToPyObject(benchmark::State& state, PyObject* (*createPayload)(int64_t), bool legacy)
+{
+    PyObject* payload = createPayload(state.range(0));
+    const nlohmann::json value = Legacy::PyObjectToJson(payload);
+
+    for (auto _ : state) 
+    {
+        PyObject* result = legacy ? Legacy::JsonToPyObject(value) : Python::JsonToPyObject(value);
+        benchmark::DoNotOptimize(result);
+        Py_XDECREF(result);
+    }
+
+    Py_DECREF(payload);
+}
+
+BENCHMARK_CAPTURE(BM_PyObjectToJson, payload_legacy, CreatePayload, true)->Arg(10)->Arg(100000);
+BENCHMARK_CAPTURE(BM_PyObjectToJson, payload,        CreatePayload, false)->Arg(10)->Arg(100000);
+BENCHMARK_CAPTURE(BM_PyObjectToJson, nested_legacy,  CreateNestedPayload, true)->Arg(16)->Arg(500);
+BENCHMARK_CAPTURE(BM_PyObjectToJson, nested,         CreateNestedPayload, false)->Arg(16)->Arg(500);
+
+BENCHMARK_CAPTURE(BM_JsonToPyObject, payload_legacy, CreatePayload, true)->Arg(10)->Arg(100000);
+BENCHMARK_CAPTURE(BM_JsonToPyObject, payload,        CreatePayload, false)->Arg(10)->Arg(100000);
+BENCHMARK_CAPTURE(BM_JsonToPyObject, nested_legacy,  CreateNestedPayload, true)->Arg(16)->Arg(500);
+BENCHMARK_CAPTURE(BM_JsonToPyObject, nested,         CreateNestedPayload, false)->Arg(16)->Arg(500);
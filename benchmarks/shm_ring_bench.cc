@@ -0,0 +1,165 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <Python.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include "backend_worker.h"
+#include "ffi.h"
+#include "plugin_executor.h"
+#include "shm_ring.h"
+
+/** `count` records shaped like a typical IPC payload, the argument list of the benchmarked call. */
+static nlohmann::json CreateCall(int64_t count)
+{
+    nlohmann::json records = nlohmann::json::array();
+
+    for (int64_t i = 0; i < count; i++) 
+    {
+        records.push_back({ { "id", i }, { "name", "plugin-" + std::to_string(i) }, { "tags", { "theme", "store" } }, { "score", i * 0.5 }, { "enabled", i % 2 == 0 }, { "parent", nullptr } });
+    }
+
+    return { { "methodName", "Backend.echo" }, { "argumentList", { { "records", std::move(records) } } } };
+}
+
+/**
+ * A backend call round trip to an out of process backend: the call is serialized into the channel, a stand in for 
+ * the worker on another thread decodes it and answers with the arguments, and the result is decoded again. 
+ * The worker attaches through duplicated handles, like a child process would. Time spent in the plugin's Python code is not included.
+ */
+static void BM_ShmChannelRoundTrip(benchmark::State& state)
+{
+    std::unique_ptr<ShmChannel> host = ShmChannel::Create(BackendWorker::RING_SIZE);
+
+    if (!host) 
+    {
+        state.SkipWithError("couldn't create a channel");
+        return;
+    }
+
+    std::vector<ShmHandle> workerHandles;
+    for (const ShmHandle handle : host->GetInheritableHandles()) 
+    {
+        workerHandles.push_back(dup(handle));
+    }
+
+    std::unique_ptr<ShmChannel> worker = ShmChannel::Attach(workerHandles, BackendWorker::RING_SIZE);
+    std::atomic<bool> stopping { false };
+
+    std::thread workerThread([&worker, &stopping]
+    {
+        std::string message;
+
+        while (!stopping.load()) 
+        {
+            if (!worker->Receive(message, std::chrono::milliseconds(50))) 
+            {
+                continue;
+            }
+
+            const nlohmann::json request = nlohmann::json::parse(message);
+            worker->Send(nlohmann::json({ 
+                { "type", "invoke_result" }, { "id", request["id"] }, { "returnType", Python::JSON }, { "plain", request["call"]["argumentList"].dump() } 
+            }).dump());
+        }
+    });
+
+    const nlohmann::json functionCall = CreateCall(state.range(0));
+    uint64_t invokeId = 0;
+    std::string response;
+
+    for (auto _ : state) 
+    {
+        host->Send(nlohmann::json({ { "type", "invoke" }, { "id", invokeId++ }, { "call", functionCall } }).dump());
+
+        if (!host->Receive(response, std::chrono::seconds(10))) 
+        {
+            state.SkipWithError("the worker didn't answer");
+            break;
+        }
+
+        const nlohmann::json result = nlohmann::json::parse(response);
+        benchmark::DoNotOptimize(result["plain"].get_ref<const std::string&>().data());
+    }
+
+    stopping.store(true);
+    workerThread.join();
+}
+
+/**
+ * The same call handed to an in process backend on its executor, the arguments are converted to Python objects 
+ * and the result back to JSON with the interpreter's GIL held, as LockGILAndInvokeMethod does.
+ */
+static void BM_ExecutorInvokeRoundTrip(benchmark::State& state)
+{
+    if (!Py_IsInitialized()) 
+    {
+        Py_Initialize();
+    }
+
+    const nlohmann::json functionCall = CreateCall(state.range(0));
+
+    /** The executor takes the GIL on its own thread, this one gives it back once done as the other Python benchmarks expect to hold it. */
+    PyThreadState* mainThreadState = PyEval_SaveThread();
+
+    auto executor = std::make_shared<PluginExecutor>("benchmark", PyInterpreterState_Main());
+    executor->Start();
+
+    for (auto _ : state) 
+    {
+        std::optional<Python::EvalResult> result = executor->Invoke<Python::EvalResult>([&functionCall]() -> Python::EvalResult
+        {
+            PyObject* arguments = Python::JsonToPyObject(functionCall["argumentList"]);
+            nlohmann::json value;
+
+            const bool converted = arguments && Python::PyObjectToJson(arguments, value);
+            Py_XDECREF(arguments);
+
+            return converted ? Python::EvalResult { value.dump(), Python::JSON } : Python::EvalResult { "conversion failed", Python::Error };
+        });
+
+        if (!result.has_value() || result->type != Python::JSON) 
+        {
+            state.SkipWithError("the executor didn't run the call");
+            break;
+        }
+        benchmark::DoNotOptimize(result->plain.data());
+    }
+
+    executor->Stop();
+    PyEval_RestoreThread(mainThreadState);
+}
+
+BENCHMARK(BM_ShmChannelRoundTrip)->Arg(1)->Arg(100)->Arg(10000)->UseRealTime();
+BENCHMARK(BM_ExecutorInvokeRoundTrip)->Arg(1)->Arg(100)->Arg(10000)->UseRealTime();
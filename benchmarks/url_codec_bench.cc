@@ -0,0 +1,136 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include "url_parser.h"
+
+/**
+ * The stream based codec shipped before the table driven rewrite, kept as the baseline.
+ */
+namespace Legacy
+{
+    static std::string UrlEncode(const std::string &value) 
+    {
+        std::ostringstream encoded;
+
+        for (unsigned char c : value) 
+        {
+            if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/')   
+                encoded << c;
+            else if (c == ' ')   
+                encoded << '+';
+            else 
+                encoded << '%' << std::uppercase << std::hex << int(c);    
+        }
+        return encoded.str();
+    }
+
+    static const std::string UrlDecode(const std::string &url) 
+    {
+        std::string decoded;
+        char ch;
+        int hexValue;
+
+        for (size_t i = 0; i < url.length(); ++i) 
+        {
+            if (url[i] == '%') 
+            {
+                if (i + 2 < url.length() && std::isxdigit(url[i + 1]) && std::isxdigit(url[i + 2])) 
+                {
+                    std::stringstream ss;
+                    ss << std::hex << url.substr(i + 1, 2);
+                    ss >> hexValue;
+                    ch = static_cast<char>(hexValue);
+                    decoded += ch;
+                    i += 2; 
+                }
+            } 
+            else if (url[i] == '+') { decoded += ' ';    } 
+            else                    { decoded += url[i]; }
+        }
+        return decoded;
+    }
+}
+
+/** A hook path that can be used as is, and one that needs escaping (spaces, parentheses and non ASCII bytes). */
+static const std::string cleanPath = "home/user/.local/share/millennium/plugins/steam-db/.millennium/Dist/index.js";
+static const std::string dirtyPath = "home/user/.local/share/millennium/plugins/Fluenty (Dark) \xC3\xA9" "dition/skins/library & store.css";
+
+static const std::string& GetPath(const benchmark::State& state)
+{
+    return state.range(0) ? dirtyPath : cleanPath;
+}
+
+static void BM_UrlEncode_Legacy(benchmark::State& state)
+{
+    const std::string& path = GetPath(state);
+    for (auto _ : state) benchmark::DoNotOptimize(Legacy::UrlEncode(path));
+}
+
+static void BM_UrlEncode(benchmark::State& state)
+{
+    const std::string& path = GetPath(state);
+    for (auto _ : state) benchmark::DoNotOptimize(UrlEncode(path));
+}
+
+static void BM_UrlEncodeInto(benchmark::State& state)
+{
+    const std::string& path = GetPath(state);
+    std::string output;
+
+    for (auto _ : state) 
+    {
+        output.clear();
+        UrlEncodeInto(path, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+static void BM_UrlDecode_Legacy(benchmark::State& state)
+{
+    const std::string url = UrlEncode(GetPath(state));
+    for (auto _ : state) benchmark::DoNotOptimize(Legacy::UrlDecode(url));
+}
+
+static void BM_UrlDecode(benchmark::State& state)
+{
+    const std::string url = UrlEncode(GetPath(state));
+    for (auto _ : state) benchmark::DoNotOptimize(UrlDecode(url));
+}
+
+/** Argument 0 benchmarks a path without anything to escape, 1 a path that needs escaping. */
+BENCHMARK(BM_UrlEncode_Legacy)->Arg(0)->Arg(1);
+BENCHMARK(BM_UrlEncode)->Arg(0)->Arg(1);
+BENCHMARK(BM_UrlEncodeInto)->Arg(0)->Arg(1);
+BENCHMARK(BM_UrlDecode_Legacy)->Arg(0)->Arg(1);
+BENCHMARK(BM_UrlDecode)->Arg(0)->Arg(1);
@@ -0,0 +1,82 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "ffi.h"
+
+/**
+ * Fire and forget events from plugin frontends to their backends.
+ *
+ * A Runtime binding is installed in the SharedJSContext, calling it emits Runtime.bindingCalled on the browser 
+ * socket without any request being paused, intercepted or base64 encoded. Events are posted to the plugin's executor 
+ * (or sent to its worker process, see BackendWorker), which runs them in order. The socket thread never waits on 
+ * Python, and a backend that blocks only holds up its own events.
+ *
+ * The frontend sends the same payload it would post to the IPC server for a server method call, i.e
+ * `MILLENNIUM_BACKEND_EVENT(JSON.stringify({ pluginName, methodName, argumentList }))`. Return values are discarded.
+ */
+class BackendEventChannel
+{
+public:
+    static BackendEventChannel& get();
+
+    /** Name of the binding installed in the SharedJSContext. */
+    static constexpr const char* BINDING_NAME = "MILLENNIUM_BACKEND_EVENT";
+    /** Events a backend hasn't handled yet are capped per plugin, further events for it are dropped until it catches up. */
+    static constexpr size_t MAX_QUEUED_EVENTS = 4096;
+
+    void Attach();
+    void DispatchSocketMessage(const nlohmann::json& message);
+    void Shutdown();
+
+    BackendEventChannel(const BackendEventChannel&) = delete;
+    BackendEventChannel& operator=(const BackendEventChannel&) = delete;
+
+private:
+    BackendEventChannel() = default;
+
+    /** Events of one plugin that were handed to its backend and haven't run yet. */
+    struct PluginBacklog {
+        size_t queuedEvents = 0;
+        unsigned long long droppedEvents = 0;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, PluginBacklog> m_backlogs;
+    std::atomic<bool> m_stop { false };
+
+    void Dispatch(const std::string& pluginName, nlohmann::json call);
+    void Complete(const std::string& pluginName, const std::string& methodName, const Python::EvalResult& result);
+};
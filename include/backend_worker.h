@@ -0,0 +1,135 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "ffi.h"
+#include "locals.h"
+#include "plugin_executor.h"
+#include "shm_ring.h"
+
+/**
+ * A plugin backend that runs in its own process instead of a sub-interpreter of Steam's, so a crash or a leak 
+ * in it (or in a native module it loads) can't take Steam down with it. Plugins opt in with `"backendHost": "process"` 
+ * in their plugin.json. Not available on macOS, such plugins fail to load there.
+ *
+ * The worker process (millennium_worker) embeds its own Python and talks to Millennium over a ShmChannel. 
+ * Calls into the backend are forwarded to it as JSON, and the `Millennium` module it sees forwards every call 
+ * back to the plugin's proxy interpreter in Steam, where it runs on the plugin's executor like any in-process call. 
+ * Only JSON values cross the boundary, callbacks and futures can't. A worker that dies is restarted with backoff.
+ */
+class BackendWorker : public std::enable_shared_from_this<BackendWorker>
+{
+public:
+    /** Bytes per direction of the channel, messages larger than this are refused. */
+    static constexpr size_t RING_SIZE = (4 * 1024 * 1024) + 64;
+    static constexpr int MAX_RESTARTS = 5;
+
+    BackendWorker(SettingsStore::PluginTypeSchema plugin, std::shared_ptr<PluginExecutor> executor);
+    ~BackendWorker();
+
+    BackendWorker(const BackendWorker&) = delete;
+    BackendWorker& operator=(const BackendWorker&) = delete;
+
+    bool Start();
+    void Stop();
+
+    using InvokeCallback = std::function<void(Python::EvalResult)>;
+
+    std::optional<Python::EvalResult> Invoke(const nlohmann::json& functionCall);
+    bool InvokeAsync(const nlohmann::json& functionCall, InvokeCallback onResult);
+    void NotifyFrontendLoaded();
+
+private:
+#ifdef _WIN32
+    using ProcessHandle = HANDLE;
+#else
+    using ProcessHandle = pid_t;
+#endif
+
+    bool Spawn();
+    bool HasExited(int& exitCode);
+    void Kill();
+    void Supervise(std::promise<bool> spawned);
+
+    void HandleMessage(const nlohmann::json& message);
+    void HandleApiCall(const nlohmann::json& message);
+    void FailPendingInvokes(const std::string& reason);
+    bool Send(const nlohmann::json& message, std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+    const SettingsStore::PluginTypeSchema m_plugin;
+    const std::shared_ptr<PluginExecutor> m_executor;
+
+    std::mutex m_mutex;
+    std::shared_ptr<ShmChannel> m_channel;
+    std::optional<ProcessHandle> m_process;
+    std::unordered_map<uint64_t, InvokeCallback> m_pendingInvokes;
+    uint64_t m_nextInvokeId = 0;
+    bool m_frontendLoaded = false;
+
+    std::atomic<bool> m_stopping { false };
+    std::condition_variable m_stopCondition;
+    std::thread m_supervisor;
+};
+
+/**
+ * Keeps track of the plugins whose backend runs out of process, see BackendWorker.
+ */
+class BackendWorkers
+{
+public:
+    static BackendWorkers& get();
+
+    static bool IsOutOfProcess(const SettingsStore::PluginTypeSchema& plugin);
+
+    bool Start(const SettingsStore::PluginTypeSchema& plugin, std::shared_ptr<PluginExecutor> executor);
+    bool Stop(const std::string& pluginName);
+    std::shared_ptr<BackendWorker> Find(const std::string& pluginName);
+
+    BackendWorkers(const BackendWorkers&) = delete;
+    BackendWorkers& operator=(const BackendWorkers&) = delete;
+
+private:
+    BackendWorkers() = default;
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<BackendWorker>> m_workers;
+};
@@ -94,11 +94,11 @@ extern "C"
     static PyMethodDef stdoutMethods[] = { {"write", CustomStdoutWrite, METH_VARARGS, "Custom stdout write function"}, {NULL, NULL, 0, NULL} };
     static PyMethodDef stderrMethods[] = { {"write", CustomStderrWrite, METH_VARARGS, "Custom stderr write function"}, {NULL, NULL, 0, NULL} };
 
-    static struct PyModuleDef customStdoutModule = { PyModuleDef_HEAD_INIT, "hook_stdout", NULL, -1, stdoutMethods };
-    static struct PyModuleDef customStderrModule = { PyModuleDef_HEAD_INIT, "hook_stderr", NULL, -1, stderrMethods };
+    static struct PyModuleDef customStdoutModule = { PyModuleDef_HEAD_INIT, "hook_stdout", NULL, 0, stdoutMethods, g_statelessModuleSlots };
+    static struct PyModuleDef customStderrModule = { PyModuleDef_HEAD_INIT, "hook_stderr", NULL, 0, stderrMethods, g_statelessModuleSlots };
 
-    PyObject* PyInit_CustomStderr(void) { return PyModule_Create(&customStderrModule); }
-    PyObject* PyInit_CustomStdout(void) { return PyModule_Create(&customStdoutModule); }
+    PyObject* PyInit_CustomStderr(void) { return PyModuleDef_Init(&customStderrModule); }
+    PyObject* PyInit_CustomStdout(void) { return PyModuleDef_Init(&customStdoutModule); }
 
     /** @brief Redirects the Python stdout and stderr to the logger. */
     const void RedirectOutput() 
@@ -0,0 +1,105 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <Python.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * Lets plugin backends listen to Chrome DevTools Protocol events on Millennium's own browser connection, 
+ * instead of every plugin opening (and fully decoding) its own websocket to the debugger port.
+ *
+ * Subscriptions are keyed by event method, so the socket thread only looks at messages somebody asked for, 
+ * and each message is parsed once no matter how many plugins listen. Matching events are posted straight to the 
+ * subscribers' executors (see PluginExecutor), which run them in order, so a slow subscriber only holds up its own 
+ * events. Commands are sent with JavaScript::SendBrowserCommandAsync.
+ *
+ * The domain an event belongs to has to be enabled by the plugin itself, i.e by sending Network.enable.
+ */
+class CdpPassthrough
+{
+public:
+    static CdpPassthrough& get();
+
+    /** Events a plugin hasn't handled yet are capped per plugin, further events for it are dropped until it catches up. */
+    static constexpr size_t MAX_QUEUED_EVENTS = 4096;
+
+    uint64_t Subscribe(std::string pluginName, std::string eventMethod, std::optional<std::string> sessionId, PyObject* callback);
+    bool Unsubscribe(const std::string& pluginName, uint64_t subscriptionId);
+    void RemovePluginSubscriptions(const std::string& pluginName);
+
+    void DispatchSocketMessage(const nlohmann::json& message);
+    void Shutdown();
+
+    CdpPassthrough(const CdpPassthrough&) = delete;
+    CdpPassthrough& operator=(const CdpPassthrough&) = delete;
+
+private:
+    CdpPassthrough() = default;
+
+    /** 
+     * `callback` is owned by the subscriber's interpreter. It is only touched with that interpreter's GIL held, 
+     * and `active` is only cleared with it held, so a delivery never races an unsubscribe.
+     */
+    struct Subscription {
+        uint64_t id;
+        std::string pluginName;
+        std::string eventMethod;
+        std::optional<std::string> sessionId;
+        PyObject* callback;
+        std::atomic<bool> active { true };
+    };
+
+    /** Events of one plugin that were posted to its executor and haven't run yet. */
+    struct PluginBacklog {
+        std::atomic<size_t> queuedEvents { 0 };
+        std::atomic<unsigned long long> droppedEvents { 0 };
+    };
+
+    struct PendingEvent {
+        std::shared_ptr<Subscription> subscription;
+        std::shared_ptr<PluginBacklog> backlog;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<Subscription>>> m_subscriptions;
+    std::unordered_map<std::string, std::shared_ptr<PluginBacklog>> m_backlogs;
+    std::atomic<bool> m_stop { false };
+    uint64_t m_nextSubscriptionId = 1;
+
+    void Deliver(const Subscription& subscription, const nlohmann::json& params, const std::optional<std::string>& sessionId);
+};
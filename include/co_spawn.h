@@ -33,6 +33,8 @@
 #include <Python.h>
 #include <thread>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include "locals.h"
 #include <condition_variable>
@@ -41,6 +43,22 @@
 #include <filesystem>
 #include "env.h"
 #include <optional>
+#include <unordered_set>
+#include <unordered_map>
+#include "plugin_executor.h"
+
+/**
+ * Module slots for Millennium's builtin modules that keep no Python state of their own. 
+ * They use multi-phase initialization so each interpreter gets its own module object, and can be imported 
+ * into interpreters that own their GIL (see PythonManager::CreatePythonInstance).
+ */
+static PyModuleDef_Slot g_statelessModuleSlots[] = 
+{
+#if PY_VERSION_HEX >= 0x030C0000
+	{ Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED },
+#endif
+	{ 0, NULL }
+};
 
 struct InterpreterMutex {
     std::mutex mtx;
@@ -56,6 +74,38 @@ struct PythonThreadState {
 	PythonThreadState(std::string pluginName, PyThreadState* thread_state, std::shared_ptr<InterpreterMutex> mutex) : pluginName(pluginName), thread_state(thread_state), mutex(mutex) {}
 };
 
+/**
+ * The running plugin backends, indexed by plugin name and by the interpreter they run in.
+ * 
+ * Lookups happen on every write to a plugin's stdout and stderr, so they never wait on a writer: readers take the 
+ * current snapshot and search it, writers build an updated copy and publish it in one step. Snapshots only change 
+ * when a backend starts or stops, so copying them is cheap compared to how often they are read.
+ */
+class PythonInstanceRegistry
+{
+public:
+	void Add(std::shared_ptr<PythonThreadState> instance, PyInterpreterState* interpreter);
+	void Remove(const std::shared_ptr<PythonThreadState>& instance);
+
+	std::shared_ptr<PythonThreadState> FindByName(const std::string& pluginName) const;
+	std::shared_ptr<PythonThreadState> FindByInterpreter(PyInterpreterState* interpreter) const;
+
+	/** All instances, in the order they were added. */
+	std::vector<std::shared_ptr<PythonThreadState>> GetAll() const;
+
+private:
+	struct Snapshot {
+		std::vector<std::shared_ptr<PythonThreadState>> instances;
+		std::unordered_map<std::string, std::shared_ptr<PythonThreadState>> byName;
+		std::unordered_map<PyInterpreterState*, std::shared_ptr<PythonThreadState>> byInterpreter;
+	};
+
+	std::shared_ptr<const Snapshot> Load() const;
+
+	std::mutex m_writeMutex;
+	std::shared_ptr<const Snapshot> m_snapshot = std::make_shared<const Snapshot>();
+};
+
 static const std::filesystem::path pythonModulesBaseDir = std::filesystem::path(GetEnv("MILLENNIUM__PYTHON_ENV"));
 
 #ifdef _WIN32
@@ -72,6 +122,12 @@ static const std::string pythonLibs     = GetEnv("LIBPYTHON_BUILTIN_MODULES_DLL_
 static const std::string pythonUserLibs = (pythonModulesBaseDir / "lib" / "python3.11" / "site-packages").generic_string();
 #endif
 
+/** 
+ * Where compiled bytecode of plugin backends and their dependencies is cached (sys.pycache_prefix), 
+ * so plugin folders stay clean. Keyed by the Python version Millennium was built against. 
+ */
+static const std::string pythonBytecodeCache = (std::filesystem::path(GetEnv("MILLENNIUM__CACHE_PATH")) / "pycache" / PY_VERSION).generic_string();
+
 class PythonManager 
 {
 private:
@@ -79,7 +135,12 @@ private:
 	PyThreadState* m_InterpreterThreadSave;
 
 	std::vector<std::tuple<std::string, std::thread>> m_threadPool;
-	std::vector<std::shared_ptr<PythonThreadState>> m_pythonInstances;
+	PythonInstanceRegistry m_pythonInstances;
+
+	/** Plugins that currently own a backend, kept separately so HasBackend never has to wait on instance teardown. */
+	std::mutex m_backendMutex;
+	std::unordered_set<std::string> m_backendPlugins;
+	std::unordered_map<std::string, std::shared_ptr<PluginExecutor>> m_executors;
 
 public:
 	PythonManager();
@@ -93,6 +154,7 @@ public:
 	bool HasBackend(std::string pluginName);
 
 	std::optional<std::shared_ptr<PythonThreadState>> GetPythonThreadStateFromName(std::string pluginName);
+	std::shared_ptr<PluginExecutor> GetPluginExecutor(const std::string& pluginName);
 	std::string GetPluginNameFromThreadState(PyThreadState* thread);
 
 	static PythonManager& GetInstance() {
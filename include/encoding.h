@@ -29,111 +29,74 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <optional>
 #include <string>
 #include <vector>
 
-// https://stackoverflow.com/questions/180947/base64-decode-snippet-in-c
-
-static const std::string base64_chars =
-             "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-             "abcdefghijklmnopqrstuvwxyz"
-             "0123456789+/";
-
-static inline bool is_base64(unsigned char c) 
-{
-    return (isalnum(c) || (c == '+') || (c == '/'));
-}
-
-static std::string Base64Decode(const std::string &in) 
+/**
+ * Base64 codec used for every body passed through Fetch.getResponseBody/Fetch.fulfillRequest and the IPC bridge.
+ * 
+ * SSSE3/AVX2 (x86) and NEON (arm64) kernels are picked once at runtime based on what the CPU supports,
+ * everything else (and the tail of every buffer) goes through a table driven scalar codec.
+ */
+namespace Base64
 {
-    std::string out;
-    std::vector<int> T(256,-1);
-    for (int i=0; i<64; i++) T["ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[i]] = i;
-
-    int val=0, valb=-8;
-    for (unsigned char c : in) 
+    enum class DecodeMode
     {
-        if (T[c] == -1) break;
-        val = (val << 6) + T[c];
-        valb += 6;
-        if (valb >= 0) 
-        {
-            out.push_back(char((val>>valb)&0xFF));
-            valb -= 8;
-        }
-    }
-    return out;
+        /** Reject anything that isn't canonical, padded base64. */
+        Strict,
+        /** Skip whitespace, accept missing padding and stop decoding at the first invalid character. */
+        Lenient
+    };
+
+    /**
+     * @brief Get the exact encoded size of `length` bytes, padding included.
+     */
+    size_t EncodedLength(size_t length);
+
+    /**
+     * @brief Get an upper bound of the decoded size of `length` base64 characters.
+     */
+    size_t MaxDecodedLength(size_t length);
+
+    /**
+     * @brief Encode into a caller owned buffer.
+     * 
+     * @param {void*} data - The bytes to encode.
+     * @param {size_t} length - The amount of bytes to encode.
+     * @param {char*} output - Destination, must hold at least EncodedLength(length) characters. It is not null terminated.
+     * @returns {size_t} - The amount of characters written.
+     */
+    size_t EncodeInto(const void* data, size_t length, char* output);
+
+    /**
+     * @brief Decode into a caller owned buffer.
+     * 
+     * @param {char*} data - The base64 characters to decode.
+     * @param {size_t} length - The amount of characters to decode.
+     * @param {void*} output - Destination, must hold at least MaxDecodedLength(length) bytes.
+     * @param {DecodeMode} mode - How malformed input is treated.
+     * @returns {std::optional<size_t>} - The amount of bytes written, or nullopt if strict decoding rejected the input.
+     */
+    std::optional<size_t> DecodeInto(const char* data, size_t length, void* output, DecodeMode mode);
+
+    /**
+     * @brief Get the name of the kernel selected for this CPU, i.e "avx2", "ssse3", "neon" or "scalar".
+     */
+    const char* GetKernelName();
 }
 
-static std::string Base64Encode(const std::vector<char>& data) 
-{
-    std::string encoded;
-    size_t i = 0;
-    size_t dataSize = data.size();
-    unsigned char char_array_3[3];
-    unsigned char char_array_4[4];
-
-    for (size_t j = 0; j < dataSize; j++) 
-    {
-        char_array_3[i++] = data[j];
-
-        if (i == 3) 
-        {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
-
-            for (i = 0; i < 4; i++) 
-            {
-                encoded += base64_chars[char_array_4[i]];
-            }
-            i = 0;
-        }
-    }
+std::string Base64Encode(const std::string& in);
+std::string Base64Encode(const std::vector<char>& data);
 
-    if (i) 
-    {
-        for (size_t j = i; j < 3; j++) 
-        {
-            char_array_3[j] = '\0';
-        }
-
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-        char_array_4[3] = char_array_3[2] & 0x3f;
-
-        for (size_t j = 0; j < i + 1; j++) 
-        {
-            encoded += base64_chars[char_array_4[j]];
-        }
-
-        while (i++ < 3) 
-        {
-            encoded += '=';
-        }
-    }
-
-    return encoded;
-}
-
-static std::string Base64Encode(const std::string &in) 
-{
-    std::string out;
+/**
+ * @brief Leniently decode base64, decoding stops at the first character that isn't part of the alphabet.
+ */
+std::string Base64Decode(const std::string& in);
 
-    int val = 0, valb = -6;
-    for (unsigned char c : in) 
-    {
-        val = (val << 8) + c;
-        valb += 8;
-        while (valb >= 0) 
-        {
-            out.push_back("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(val>>valb)&0x3F]);
-            valb -= 6;
-        }
-    }
-    if (valb>-6) out.push_back("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[((val<<8)>>(valb+8))&0x3F]);
-    while (out.size()%4) out.push_back('=');
-    return out;
-}
\ No newline at end of file
+/**
+ * @brief Strictly decode base64.
+ * @returns {std::optional<std::string>} - The decoded bytes, or nullopt if the input isn't canonical, padded base64.
+ */
+std::optional<std::string> Base64DecodeStrict(const std::string& in);
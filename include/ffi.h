@@ -35,6 +35,10 @@
 #include <fmt/core.h>
 #include "internal_logger.h"
 #include <thread>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <optional>
 
 class PythonGIL : public std::enable_shared_from_this<PythonGIL>
 {
@@ -70,6 +74,14 @@ namespace Python {
 
     std::tuple<std::string, std::string> ActiveExceptionInformation();
 
+	/** Values nested deeper than this are refused by the converters below, which also catches reference cycles. */
+	static constexpr int MAX_JSON_DEPTH = 512;
+	/** Gets the first say on every JSON object JsonToPyObject converts, returns true with `result` set (or NULL with an exception) if it handled it. */
+	using JsonObjectHook = bool (*)(const nlohmann::json& object, PyObject*& result);
+
+	PyObject* JsonToPyObject(const nlohmann::json& value, JsonObjectHook objectHook = nullptr);
+	bool PyObjectToJson(PyObject* object, nlohmann::json& value);
+
 	EvalResult LockGILAndInvokeMethod(std::string pluginName, nlohmann::json script);
 	void CallFrontEndLoaded(std::string pluginName);
 }
@@ -89,13 +101,18 @@ namespace JavaScript {
     };
 
     using EventHandler = std::function<void(const nlohmann::json& eventMessage, std::string listenerId)>;
+    using ResponseHandler = std::function<void(const nlohmann::json& response)>;
 
     class SharedJSMessageEmitter {
     private:
         SharedJSMessageEmitter() {}
 
+        /** Guards all maps. Handlers are always invoked without it held, so they may add or remove listeners themselves. */
+        std::mutex listenerMutex;
         std::unordered_map<std::string, std::vector<std::pair<std::string, EventHandler>>> events;
         std::unordered_map<std::string, std::vector<nlohmann::json>> missedMessages; // New data structure for missed messages
+        /** One shot handlers waiting on the response to a request, keyed by the request's message id. */
+        std::unordered_map<int64_t, ResponseHandler> pendingResponses;
 
     public:
         SharedJSMessageEmitter(const SharedJSMessageEmitter&) = delete;
@@ -107,22 +124,31 @@ namespace JavaScript {
         }
 
         std::string OnMessage(const std::string& event, const std::string name, EventHandler handler) {
-            events[event].push_back(std::make_pair(name, handler));
-            // Deliver any missed messages
-            auto it = missedMessages.find(event);
-            if (it != missedMessages.end()) 
+            std::vector<nlohmann::json> pendingMessages;
             {
-                for (const auto message : it->second) 
+                std::lock_guard<std::mutex> lock(listenerMutex);
+                events[event].push_back(std::make_pair(name, handler));
+
+                auto it = missedMessages.find(event);
+                if (it != missedMessages.end()) 
                 {
-                    handler(message, name);
+                    pendingMessages = std::move(it->second);
+                    missedMessages.erase(it); // Clear missed messages once delivered
                 }
-                missedMessages.erase(it); // Clear missed messages once delivered
+            }
+
+            // Deliver any missed messages
+            for (const auto& message : pendingMessages) 
+            {
+                handler(message, name);
             }
             return name;
         }
 
         void RemoveListener(const std::string& event, std::string listenerId) 
         {
+            std::lock_guard<std::mutex> lock(listenerMutex);
+
             auto it = events.find(event);
             if (it != events.end()) 
             {
@@ -139,31 +165,101 @@ namespace JavaScript {
             }
         }
 
+        /**
+         * @brief Wait on the response with the given message id, the handler is invoked at most once and then forgotten.
+         * Responses routed to a handler this way are not broadcast to the listeners registered with OnMessage.
+         */
+        void OnResponse(int64_t messageId, ResponseHandler handler) 
+        {
+            std::lock_guard<std::mutex> lock(listenerMutex);
+            pendingResponses[messageId] = std::move(handler);
+        }
+
+        void RemoveResponseHandler(int64_t messageId) 
+        {
+            std::lock_guard<std::mutex> lock(listenerMutex);
+            pendingResponses.erase(messageId);
+        }
+
         void EmitMessage(const std::string& event, const nlohmann::json& data) {
-            auto it = events.find(event);
-            if (it != events.end()) 
+            std::vector<std::pair<std::string, EventHandler>> handlers;
+            ResponseHandler responseHandler;
             {
-                const auto& handlers = it->second;
-                for (const auto& handler : handlers) 
+                std::lock_guard<std::mutex> lock(listenerMutex);
+
+                auto messageId = data.find("id");
+                auto pending = messageId != data.end() && messageId->is_number_integer() ? pendingResponses.find(messageId->get<int64_t>()) : pendingResponses.end();
+
+                if (pending != pendingResponses.end()) 
                 {
-                    try 
-                    {
-                        handler.second(data, handler.first);
-                    } 
-                    catch (const std::bad_function_call& e) 
+                    responseHandler = std::move(pending->second);
+                    pendingResponses.erase(pending);
+                }
+                else 
+                {
+                    auto it = events.find(event);
+                    if (it == events.end()) 
                     {
-                        Logger.Warn("Failed to emit message on {}. exception: {}", handler.first, e.what());
+                        missedMessages[event].push_back(data);
+                        return;
                     }
+                    handlers = it->second;
                 }
-            } 
-            else 
+            }
+
+            if (responseHandler) 
             {
-                missedMessages[event].push_back(data);
+                responseHandler(data);
+                return;
+            }
+
+            for (const auto& handler : handlers) 
+            {
+                try 
+                {
+                    handler.second(data, handler.first);
+                } 
+                catch (const std::bad_function_call& e) 
+                {
+                    Logger.Warn("Failed to emit message on {}. exception: {}", handler.first, e.what());
+                }
             }
         }
     };
 
-	const std::string ConstructFunctionCall(const char* value, const char* methodName, std::vector<JavaScript::JsFunctionConstructTypes> params);
+    struct FunctionCall 
+    {
+        std::string methodName;
+        std::vector<JsFunctionConstructTypes> params;
+    };
+
+	const std::string ConstructFunctionCall(const char* value, const char* methodName, std::vector<JavaScript::JsFunctionConstructTypes> params, bool binaryResults = false);
+	const std::string ConstructBatchedFunctionCall(const char* plugin, const std::vector<FunctionCall>& calls, bool binaryResults = false);
+	const std::string GuardFrontendLoaded(const std::string& pluginName, const std::string& script);
+
+	/** How long a frontend evaluation may take before the calling Python thread gets a TimeoutError. */
+	static constexpr std::chrono::milliseconds DEFAULT_EVALUATE_TIMEOUT = std::chrono::seconds(30);
+
+	PyObject* EvaluateFromSocket(std::string script, std::chrono::milliseconds timeout = DEFAULT_EVALUATE_TIMEOUT, bool binaryResults = false);
+	PyObject* EvaluateBatchFromSocket(std::string pluginName, std::string script, std::chrono::milliseconds timeout = DEFAULT_EVALUATE_TIMEOUT, bool binaryResults = false);
+
+	PyObject* InvokeFrontendMethod(std::string pluginName, std::string methodName, std::vector<JsFunctionConstructTypes> params, std::chrono::milliseconds timeout = DEFAULT_EVALUATE_TIMEOUT, bool binaryResults = false);
+	PyObject* InvokeFrontendMethodAsync(std::string pluginName, std::string methodName, std::vector<JsFunctionConstructTypes> params, std::chrono::milliseconds timeout = DEFAULT_EVALUATE_TIMEOUT, bool binaryResults = false);
+
+	/** Drops cached frontend method handles, called when attaching to a new SharedJSContext session. */
+	void ResetFrontendMethodCache();
+
+	/** 
+	 * Frontend method calls made before the plugin's frontend is loaded are deferred until it is, see DeferredFrontendCalls.
+	 * MarkFrontendReady is driven by the FrontEndLoaded IPC message, ResetFrontendReadiness by attaching to a SharedJSContext session.
+	 * MarkBackendReady and ForgetBackendReady follow Millennium.ready() and backend unloads, blocking calls are only deferred in between.
+	 */
+	void MarkFrontendReady(const std::string& pluginName);
+	void MarkBackendReady(const std::string& pluginName);
+	void ForgetBackendReady(const std::string& pluginName);
+	void ResetFrontendReadiness();
+	void CancelDeferredFrontendCalls();
 
-	PyObject* EvaluateFromSocket(std::string script);
+	/** Sends a raw CDP command over the browser connection, returns an asyncio.Future resolving to its result. */
+	PyObject* SendBrowserCommandAsync(std::string pluginName, std::string method, nlohmann::json params, std::optional<std::string> sessionId, std::chrono::milliseconds timeout = DEFAULT_EVALUATE_TIMEOUT);
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "plugin_logger.h"
+#include "locals.h"
+
+/**
+ * Captures console output and uncaught exceptions from plugin frontends running in the SharedJSContext.
+ *
+ * Runtime.consoleAPICalled and Runtime.exceptionThrown are attributed to a plugin by the script URL of the 
+ * call site (frontends are served from https://millennium.ftp/<plugin path>) and kept in a fixed size ring 
+ * per plugin, so a chatty frontend can never grow memory. Entries are read back through get_plugin_logs.
+ */
+class FrontendConsole
+{
+public:
+    static FrontendConsole& get();
+
+    /** Entries kept per plugin, the oldest are overwritten first. */
+    static constexpr size_t MAX_ENTRIES_PER_PLUGIN = 512;
+    /** Longer messages are truncated before they are stored. */
+    static constexpr size_t MAX_MESSAGE_LENGTH = 4096;
+
+    void SetPlugins(const std::vector<SettingsStore::PluginTypeSchema>& plugins);
+    void DispatchSocketMessage(const nlohmann::json& message);
+    std::vector<BackendLogger::LogEntry> CollectLogs(const std::string& pluginName);
+    std::vector<std::string> GetPluginNames();
+
+    FrontendConsole(const FrontendConsole&) = delete;
+    FrontendConsole& operator=(const FrontendConsole&) = delete;
+
+private:
+    FrontendConsole() = default;
+
+    /** Fixed capacity ring, storage is allocated once on the first write. */
+    struct ConsoleRing {
+        std::vector<BackendLogger::LogEntry> entries;
+        size_t head = 0;
+        size_t count = 0;
+
+        void Push(BackendLogger::LogEntry entry);
+        std::vector<BackendLogger::LogEntry> Snapshot() const;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, ConsoleRing> m_rings;
+
+    /** Directory prefixes served for each plugin, longest first. Replaced by SetPlugins, only read on the socket thread. */
+    std::vector<std::pair<std::string, std::string>> m_pluginDirectories;
+
+    std::string AttributeUrl(const std::string& url);
+    std::string AttributeStackTrace(const nlohmann::json& stackTrace);
+    void Record(const std::string& pluginName, std::string message, BackendLogger::LogLevel level);
+};
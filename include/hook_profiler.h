@@ -0,0 +1,114 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * Records a latency waterfall for every request the HttpHookManager intercepts.
+ * 
+ * Each request is opened when its Fetch.requestPaused message is dispatched, marked at the end of every stage
+ * (i.e getResponseBody, base64Decode, match, patch, base64Encode, fulfill) and closed once it was fulfilled.
+ * Stage durations are aggregated into log2 histograms per URL pattern (request kind + origin),
+ * and the most recent requests are kept for a chrome://tracing compatible dump.
+ *
+ * Profiling is off by default, every call is a single relaxed load until it is enabled with SetEnabled().
+ */
+class HookProfiler
+{
+public:
+    static HookProfiler& get();
+
+    void Begin(const std::string& requestId, const std::string& url, const char* kind);
+    void Mark(const std::string& requestId, const char* stage);
+    void End(const std::string& requestId);
+    void Discard(const std::string& requestId);
+
+    void SetEnabled(bool isEnabled);
+    bool IsEnabled() const;
+
+    nlohmann::json GetHistograms() const;
+    nlohmann::json GetChromeTrace() const;
+
+    HookProfiler(const HookProfiler&) = delete;
+    HookProfiler& operator=(const HookProfiler&) = delete;
+
+private:
+    HookProfiler();
+
+    using Clock = std::chrono::steady_clock;
+
+    /** Buckets are powers of two in microseconds, the last bucket collects everything above ~16 seconds. */
+    static constexpr size_t m_bucketCount = 25;
+    static constexpr size_t m_maxRecentTraces = 512;
+    static constexpr size_t m_maxInFlight = 1024;
+
+    struct StageMark {
+        const char* stage;
+        Clock::time_point time;
+    };
+
+    struct RequestTrace {
+        std::string url;
+        std::string pattern;
+        Clock::time_point start;
+        std::vector<StageMark> marks;
+        unsigned long long sequence;
+    };
+
+    struct Histogram {
+        unsigned long long count = 0;
+        unsigned long long totalMicros = 0;
+        unsigned long long maxMicros = 0;
+        std::array<unsigned long long, m_bucketCount> buckets{};
+
+        void Add(unsigned long long micros);
+    };
+
+    std::atomic<bool> m_isEnabled{false};
+    mutable std::mutex m_profilerMutex;
+    Clock::time_point m_epoch;
+    unsigned long long m_sequence = 0;
+
+    std::unordered_map<std::string, RequestTrace> m_inFlight;
+    std::map<std::string, std::map<std::string, Histogram>> m_histograms;
+    std::deque<RequestTrace> m_recentTraces;
+
+    void EvictOldestInFlight();
+};
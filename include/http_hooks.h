@@ -42,6 +42,8 @@
 #include <regex>
 #include <filesystem>
 #include <chrono>
+#include <optional>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 
 extern std::atomic<unsigned long long> g_hookedModuleId;
@@ -63,6 +65,21 @@ public:
         unsigned long long id;
     };
     
+    enum RewriteAction {
+        REPLACE,
+        INSERT_BEFORE,
+        INSERT_AFTER
+    };
+
+    /** A declarative edit applied to matching documents before they reach the renderer. */
+    struct RewriteRule {
+        std::regex urlPattern;
+        std::string match;
+        std::string content;
+        RewriteAction action;
+        unsigned long long id;
+    };
+    
     enum RedirectType {
         REDIRECT = 301,
         MOVED_PERMANENTLY = 302,
@@ -75,16 +92,22 @@ public:
     void SetupGlobalHooks();
     void AddHook(const HookType& hook);
     bool RemoveHook(unsigned long long hookId);
+    void AddRewriteRule(const RewriteRule& rule);
 
     // Thread-safe hook list operations
     void SetHookList(std::shared_ptr<std::vector<HookType>> hookList);
     std::vector<HookType> GetHookListCopy() const;
+    std::vector<RewriteRule> GetRewriteRulesCopy() const;
 
     // Delete copy constructor and assignment operator for singleton
     HttpHookManager(const HttpHookManager&) = delete;
     HttpHookManager& operator=(const HttpHookManager&) = delete;
 
 private:
+    /** Drive PatchDocumentContents from benchmarks/core_bench.cc and tests/document_patch_test.cc */
+    friend class HttpHookManagerBenchmark;
+    friend class HttpHookManagerTest;
+
     HttpHookManager();
     ~HttpHookManager();
 
@@ -130,6 +153,7 @@ private:
     
     // Protected data structures
     std::shared_ptr<std::vector<HookType>> m_hookListPtr;
+    std::vector<RewriteRule> m_rewriteRules;
     
     struct WebHookItem {
         long long id;
@@ -138,13 +162,26 @@ private:
         nlohmann::basic_json<> message;
     };
     std::shared_ptr<std::vector<WebHookItem>> m_requestMap;
+
+    /** Assets at or below this size are embedded into the document shim instead of being fetched. */
+    const std::uintmax_t m_inlineAssetThreshold = 8 * 1024;
+
+    struct InlineAssetItem {
+        std::uintmax_t fileSize;
+        std::filesystem::file_time_type lastWriteTime;
+        std::optional<std::string> fragment;
+    };
+    mutable std::mutex m_inlineAssetMutex;
+    std::unordered_map<std::string, InlineAssetItem> m_inlineAssetCache;
     
     // Private methods
     bool IsIpcCall(const nlohmann::basic_json<>& message);
     bool IsGetBodyCall(const nlohmann::basic_json<>& message);
     std::string HandleCssHook(const std::string& body);
     std::string HandleJsHook(const std::string& body);
-    const std::string PatchDocumentContents(const std::string& requestUrl, const std::string& original);
+    std::optional<std::string> GetInlineAsset(const std::string& path, TagTypes type);
+    bool CanInlineAssets(const nlohmann::basic_json<>& response, const std::string& document);
+    const std::string PatchDocumentContents(const std::string& requestUrl, const std::string& original, const std::string& requestId = {}, bool canInlineAssets = false);
     void HandleHooks(const nlohmann::basic_json<>& message);
     void RetrieveRequestFromDisk(const nlohmann::basic_json<>& message);
     void GetResponseBody(const nlohmann::basic_json<>& message);
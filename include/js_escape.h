@@ -0,0 +1,59 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace JavaScript
+{
+    enum class EscapeContext
+    {
+        /** Body of a quoted JavaScript string literal, single and double quotes are both escaped. */
+        String,
+        /** Body of a JSON string, only escapes JSON allows are emitted. */
+        Json
+    };
+
+    /**
+     * @brief Append `input` to `output`, escaped to be placed between double quotes in generated code.
+     * 
+     * Both contexts escape quotes, backslashes and control characters, U+2028/U+2029 (line terminators in pre ES2019 JavaScript)
+     * and "</" / "<!--" so the result can't terminate a surrounding <script> element.
+     * Runs of bytes that need no escaping are located with SIMD (where available) and copied in bulk.
+     * 
+     * @param {std::string_view} input - The UTF-8 string to escape.
+     * @param {std::string&} output - Sink the escaped string is appended to.
+     * @param {EscapeContext} context - The kind of literal the result is placed in.
+     */
+    void EscapeStringInto(std::string_view input, std::string& output, EscapeContext context = EscapeContext::String);
+
+    std::string EscapeString(std::string_view input, EscapeContext context = EscapeContext::String);
+}
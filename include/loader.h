@@ -69,5 +69,6 @@ private:
 namespace Sockets {
 	bool PostShared(nlohmann::json data);
 	bool PostGlobal(nlohmann::json data);
+	bool IsSharedJsContextMessage(const nlohmann::json& message);
 	void Shutdown();
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <Python.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+/**
+ * A long lived thread that runs all work a plugin's backend is given from the outside world, i.e IPC calls, 
+ * frontend results and DevTools events, against one persistent thread state of the plugin's interpreter.
+ *
+ * Work is run strictly in the order it was posted, one item at a time, and without creating and tearing down a 
+ * thread state per call. If a work item blocks on the frontend (see ExecuteOnSharedJsContext), the executor keeps 
+ * running newly posted work while it waits, so a frontend that calls back into the same backend can't deadlock it.
+ */
+class PluginExecutor : public std::enable_shared_from_this<PluginExecutor>
+{
+public:
+    using Task = std::function<void()>;
+
+    PluginExecutor(std::string pluginName, PyInterpreterState* interpreter);
+    ~PluginExecutor();
+
+    PluginExecutor(const PluginExecutor&) = delete;
+    PluginExecutor& operator=(const PluginExecutor&) = delete;
+
+    void Start();
+    void Stop();
+
+    bool Post(Task task);
+    bool RunAlongside(const Task& task);
+
+    /**
+     * @brief Run `function` on the executor with the interpreter's GIL held and wait for its result.
+     * @returns {std::optional<T>} - std::nullopt if the executor has been stopped and the work was never run.
+     */
+    template <typename T>
+    std::optional<T> Invoke(std::function<T()> function)
+    {
+        if (IsCurrentThread()) 
+        {
+            return function();
+        }
+
+        auto task = std::make_shared<std::packaged_task<T()>>(std::move(function));
+        std::future<T> result = task->get_future();
+
+        if (!this->Post([task] { (*task)(); })) 
+        {
+            return std::nullopt;
+        }
+        return result.get();
+    }
+
+    bool IsCurrentThread() const;
+    static std::shared_ptr<PluginExecutor> Current();
+
+    bool RunPendingUntil(const std::function<bool()>& isDone, std::chrono::steady_clock::time_point deadline);
+    void Wake();
+
+    const std::string& GetPluginName() const { return m_pluginName; }
+    PyInterpreterState* GetInterpreter() const { return m_interpreter; }
+
+private:
+    void Run();
+    void RunBatch(std::deque<Task>& batch);
+
+    const std::string m_pluginName;
+    PyInterpreterState* const m_interpreter;
+    PyThreadState* m_threadState = nullptr;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Task> m_queue;
+    uint64_t m_wakeSequence = 0;
+    bool m_stopping = false;
+    /** Set once the executor released its thread state, RunAlongside is refused from then on. */
+    bool m_finished = false;
+    size_t m_runningAlongside = 0;
+
+    std::thread m_thread;
+    std::thread::id m_threadId;
+};
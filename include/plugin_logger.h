@@ -41,6 +41,7 @@
 #include "locals.h"
 #include "internal_logger.h"
 #include <vector>
+#include <mutex>
 #include "env.h"
 
 #define RED "\033[31m"
@@ -71,6 +72,8 @@ private:
     std::string filename;
     std::string pluginName;
 
+    /** Loggers are written to from every plugin interpreter and from Millennium's own threads. */
+    std::mutex bufferMutex;
     std::vector<LogEntry> logBuffer;
 
     std::string GetLocalTime(bool withHours = false)
@@ -126,6 +129,7 @@ public:
 
     void Log(const std::string& message, bool onlyBuffer = false) 
     {        
+        std::lock_guard<std::mutex> lock(bufferMutex);
         std::string formatted = fmt::format("{} ", GetPluginName());
 
         if (!onlyBuffer) 
@@ -141,6 +145,8 @@ public:
 
     void Warn(const std::string& message, bool onlyBuffer = false) 
     {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+
         if (!onlyBuffer)
         {
             std::string formatted = fmt::format("{}{}{}", GetLocalTime(), fmt::format(" {} ", GetPluginName()), message.c_str());
@@ -155,6 +161,8 @@ public:
 
     void Error(const std::string& message, bool onlyBuffer = false) 
     {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+
         if (!onlyBuffer) 
         {
             std::string formatted = fmt::format("{}{}{}", GetLocalTime(), fmt::format(" {} ", GetPluginName()), message.c_str());
@@ -169,6 +177,7 @@ public:
 
     void Print(const std::string& message) 
     {
+        std::lock_guard<std::mutex> lock(bufferMutex);
         file << message;
         file.flush();
 
@@ -177,6 +186,7 @@ public:
 
     std::vector<LogEntry> CollectLogs() 
     {
+        std::lock_guard<std::mutex> lock(bufferMutex);
         return logBuffer;
     }
 
@@ -193,10 +203,14 @@ public:
     }
 };
 
+/** Loggers are only added to the list (and freed on exit), hold g_loggerListMutex while looking through it. */
+extern std::mutex g_loggerListMutex;
 extern std::vector<BackendLogger*> g_loggerList;
 
 static void AddLoggerMessage(const std::string pluginName, const std::string message, BackendLogger::LogLevel level) 
 {
+    std::lock_guard<std::mutex> lock(g_loggerListMutex);
+
     for (auto logger : g_loggerList) 
     {
         if (logger->GetPluginName(false) == pluginName) 
@@ -229,6 +243,8 @@ static const void ErrorToLogger(const std::string pluginNme, const std::string m
 
 static const void RawToLogger(const std::string pluginName, const std::string message) 
 {
+    std::lock_guard<std::mutex> lock(g_loggerListMutex);
+
     for (auto logger : g_loggerList) 
     {
         if (logger->GetPluginName(false) == pluginName) 
@@ -251,5 +267,4 @@ typedef struct
 } 
 LoggerObject;
 
-extern PyTypeObject LoggerType;
 PyObject* PyInit_Logger(void);
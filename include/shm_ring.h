@@ -0,0 +1,184 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/** Something a child process can inherit, it receives the numeric value on its command line. */
+#ifdef _WIN32
+using ShmHandle = HANDLE;
+#else
+using ShmHandle = int;
+#endif
+
+/**
+ * @brief Lets one process wake up another that is blocked waiting on it.
+ * Backed by an eventfd on Linux and an auto reset event on Windows.
+ */
+class Doorbell
+{
+public:
+    static std::optional<Doorbell> Create();
+    explicit Doorbell(ShmHandle handle) : m_handle(handle) { }
+    ~Doorbell();
+
+    Doorbell(Doorbell&& other) noexcept;
+    Doorbell& operator=(Doorbell&& other) = delete;
+    Doorbell(const Doorbell&) = delete;
+
+    void Ring();
+    bool Wait(std::chrono::milliseconds timeout);
+
+    ShmHandle GetHandle() const { return m_handle; }
+
+private:
+    ShmHandle m_handle;
+};
+
+/**
+ * @brief Shared memory both processes map, backed by a memfd on Linux and a page file mapping on Windows.
+ */
+class SharedMemoryRegion
+{
+public:
+    static std::optional<SharedMemoryRegion> Create(size_t size);
+    static std::optional<SharedMemoryRegion> Attach(ShmHandle handle, size_t size);
+    ~SharedMemoryRegion();
+
+    SharedMemoryRegion(SharedMemoryRegion&& other) noexcept;
+    SharedMemoryRegion& operator=(SharedMemoryRegion&& other) = delete;
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+
+    void* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    ShmHandle GetHandle() const { return m_handle; }
+
+private:
+    SharedMemoryRegion(ShmHandle handle, void* data, size_t size) : m_handle(handle), m_data(data), m_size(size) { }
+
+    ShmHandle m_handle;
+    void* m_data;
+    size_t m_size;
+};
+
+/**
+ * Control block at the start of each ring. Positions only ever grow (wrapping at 2^32), the producer owns `tail` and
+ * the consumer owns `head`.
+ * The waiting flags let either side skip ringing the doorbell when nobody is asleep on it.
+ */
+struct ShmRingHeader
+{
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> consumerWaiting;
+    std::atomic<uint32_t> producerWaiting;
+    uint32_t capacity;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "ring positions have to be lock free to be shared between processes");
+
+/**
+ * @brief A single producer, single consumer queue of length prefixed messages in shared memory.
+ * 
+ * Messages are copied straight into the ring and may wrap around its end. A blocked reader or writer sleeps on a 
+ * Doorbell, which the other side only rings when it actually went to sleep, so a busy ring costs no syscalls.
+ */
+class ShmRing
+{
+public:
+    ShmRing(void* memory, size_t size, Doorbell& dataBell, Doorbell& spaceBell);
+
+    static void Initialize(void* memory, size_t size);
+
+    bool Write(std::string_view message, std::chrono::milliseconds timeout);
+    bool Read(std::string& message, std::chrono::milliseconds timeout);
+
+    /** The largest message that fits, a message has to fit the ring in one piece. */
+    size_t GetMaxMessageSize() const { return m_capacity - sizeof(uint32_t); }
+    /** The other side left the ring in a state a well behaved producer can't, nothing is read from it anymore. */
+    bool IsCorrupt() const { return m_isCorrupt; }
+
+private:
+    void CopyIn(uint32_t position, const void* source, size_t length);
+    void CopyOut(uint32_t position, void* destination, size_t length) const;
+
+    ShmRingHeader* m_header;
+    uint8_t* m_data;
+    uint32_t m_capacity;
+    Doorbell& m_dataBell;
+    Doorbell& m_spaceBell;
+    bool m_isCorrupt = false;
+};
+
+/**
+ * @brief A bidirectional message channel between Millennium and one child process, two ShmRings in one region.
+ * 
+ * The host creates the channel and hands GetInheritableHandles() to the child, which attaches with the same values.
+ * Send may be called from any thread, Receive from one thread at a time.
+ * 
+ * Neither side trusts what the other wrote into the shared memory. Once IsBroken() is set the channel has to be torn down.
+ */
+class ShmChannel
+{
+public:
+    /** Handles in the order Attach expects them: region, then the data and space doorbells of both rings. */
+    static constexpr size_t HANDLE_COUNT = 5;
+
+    static std::unique_ptr<ShmChannel> Create(size_t ringSize);
+    static std::unique_ptr<ShmChannel> Attach(const std::vector<ShmHandle>& handles, size_t ringSize);
+
+    bool Send(std::string_view message, std::chrono::milliseconds timeout = std::chrono::seconds(10));
+    bool Receive(std::string& message, std::chrono::milliseconds timeout);
+    bool IsBroken() const { return m_inbound->IsCorrupt(); }
+
+    std::vector<ShmHandle> GetInheritableHandles() const;
+    size_t GetMaxMessageSize() const { return m_outbound->GetMaxMessageSize(); }
+
+private:
+    ShmChannel(SharedMemoryRegion region, std::vector<Doorbell> doorbells, size_t ringSize, bool isHost);
+
+    SharedMemoryRegion m_region;
+    std::vector<Doorbell> m_doorbells;
+
+    std::mutex m_sendMutex;
+    std::unique_ptr<ShmRing> m_outbound;
+    std::unique_ptr<ShmRing> m_inbound;
+};
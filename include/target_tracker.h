@@ -0,0 +1,81 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+/**
+ * Follows the lifecycle of every CEF target through the browser connection.
+ *
+ * Target discovery keeps a live map of targets, their URLs and the session Millennium holds on them.
+ * Web pages outside of the Steam client are attached to once, and the per-target setup (i.e. bypassing
+ * the page's Content Security Policy so injected modules may load) is applied a single time per target,
+ * instead of after every patched document.
+ */
+class TargetTracker
+{
+public:
+    static TargetTracker& get();
+
+    struct TargetItem {
+        std::string targetId;
+        std::string type;
+        std::string url;
+        std::string title;
+        std::string sessionId;
+        bool isAttachPending = false;
+        bool isCspBypassed = false;
+    };
+
+    void SetupTargetDiscovery();
+    void DispatchSocketMessage(const nlohmann::json& message);
+
+    std::unordered_map<std::string, TargetItem> GetTargetsCopy() const;
+    std::string GetSessionId(const std::string& targetId) const;
+    bool IsCspBypassed(const std::string& targetId) const;
+
+    TargetTracker(const TargetTracker&) = delete;
+    TargetTracker& operator=(const TargetTracker&) = delete;
+
+private:
+    TargetTracker() = default;
+
+    mutable std::mutex m_targetMutex;
+    std::unordered_map<std::string, TargetItem> m_targets;
+
+    bool ShouldAttach(const TargetItem& target) const;
+    void UpdateTarget(const nlohmann::json& targetInfo);
+    void OnAttachedToTarget(const nlohmann::json& params);
+    void OnDetachedFromTarget(const nlohmann::json& params);
+    void ApplyTargetSetup(const std::string& sessionId);
+};
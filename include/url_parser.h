@@ -28,76 +28,220 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <string>
-#include <sstream>
-#include <iostream>
-#include <string>
-#include <iomanip>
+#include <string_view>
+
+/**
+ * URL escaping for virtual host paths, i.e https://millennium.ftp/<encoded path>
+ * 
+ * Both directions are table driven and write straight into a caller supplied std::string, 
+ * inputs that don't need any changes are detected up front and copied through as is.
+ */
+namespace UrlCodec 
+{
+    static constexpr char hexDigits[] = "0123456789ABCDEF";
+
+    /** Characters passed through as is, everything else besides ' ' (encoded as '+') is percent encoded. */
+    static constexpr std::array<bool, 256> MakeUnreservedTable()
+    {
+        std::array<bool, 256> table{};
+
+        for (int c = '0'; c <= '9'; c++) table[c] = true;
+        for (int c = 'A'; c <= 'Z'; c++) table[c] = true;
+        for (int c = 'a'; c <= 'z'; c++) table[c] = true;
+        for (unsigned char c : std::string_view("-_.~/")) table[c] = true;
+
+        return table;
+    }
+
+    /** Maps hex digits to their value, -1 for anything else. */
+    static constexpr std::array<int8_t, 256> MakeHexTable()
+    {
+        std::array<int8_t, 256> table{};
+
+        for (size_t i = 0; i < table.size(); i++) table[i] = -1;
+        for (int c = '0'; c <= '9'; c++)          table[c] = int8_t(c - '0');
+        for (int c = 'A'; c <= 'F'; c++)          table[c] = int8_t(c - 'A' + 10);
+        for (int c = 'a'; c <= 'f'; c++)          table[c] = int8_t(c - 'a' + 10);
+
+        return table;
+    }
+
+    static constexpr std::array<bool, 256> unreserved = MakeUnreservedTable();
+    static constexpr std::array<int8_t, 256> hexValues = MakeHexTable();
 
-static std::string UrlEncode(const std::string &value) 
+    /**
+     * @brief Get the position of the first character that would be changed by UrlEncode.
+     * @returns {size_t} - The position, or std::string_view::npos if the value can be used as is.
+     */
+    static inline size_t FindFirstUnsafe(std::string_view value)
+    {
+        for (size_t i = 0; i < value.size(); i++) 
+        {
+            if (!unreserved[static_cast<unsigned char>(value[i])]) 
+                return i;
+        }
+        return std::string_view::npos;
+    }
+
+    /**
+     * @brief Get the position of the first character that would be changed by UrlDecode.
+     * @returns {size_t} - The position, or std::string_view::npos if the value can be used as is.
+     */
+    static inline size_t FindFirstEscape(std::string_view url)
+    {
+        for (size_t i = 0; i < url.size(); i++) 
+        {
+            if (url[i] == '%' || url[i] == '+') 
+                return i;
+        }
+        return std::string_view::npos;
+    }
+}
+
+/**
+ * @brief Append the URL encoded form of `value` to `output`.
+ * 
+ * @param {std::string_view} value - The value to encode.
+ * @param {std::string&} output - Sink the encoded value is appended to, it is grown at most once.
+ */
+static void UrlEncodeInto(std::string_view value, std::string& output)
 {
-    std::ostringstream encoded;
+    const size_t firstUnsafe = UrlCodec::FindFirstUnsafe(value);
+
+    if (firstUnsafe == std::string_view::npos) 
+    {
+        output.append(value.data(), value.size());
+        return;
+    }
 
-    for (unsigned char c : value) 
+    size_t encodedLength = value.size();
+    for (size_t i = firstUnsafe; i < value.size(); i++) 
     {
-        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/')   
-            encoded << c;
-        else if (c == ' ')   
-            encoded << '+';
+        const unsigned char c = static_cast<unsigned char>(value[i]);
+        if (!UrlCodec::unreserved[c] && c != ' ') encodedLength += 2;
+    }
+
+    const size_t offset = output.size();
+    output.resize(offset + encodedLength);
+
+    char* cursor = &output[offset];
+    cursor = std::copy(value.data(), value.data() + firstUnsafe, cursor);
+
+    for (size_t i = firstUnsafe; i < value.size(); i++) 
+    {
+        const unsigned char c = static_cast<unsigned char>(value[i]);
+
+        if (UrlCodec::unreserved[c]) 
+        {
+            *cursor++ = static_cast<char>(c);
+        }
+        else if (c == ' ') 
+        {
+            *cursor++ = '+';
+        }
         else 
-            encoded << '%' << std::uppercase << std::hex << int(c);    
+        {
+            *cursor++ = '%';
+            *cursor++ = UrlCodec::hexDigits[c >> 4];
+            *cursor++ = UrlCodec::hexDigits[c & 0x0F];
+        }
     }
-    return encoded.str();
 }
 
-static const std::string UrlDecode(const std::string &url) 
+static std::string UrlEncode(std::string_view value) 
 {
-    std::string decoded;
-    char ch;
-    int hexValue;
+    std::string encoded;
+    UrlEncodeInto(value, encoded);
+    return encoded;
+}
 
-    for (size_t i = 0; i < url.length(); ++i) 
+/**
+ * @brief Append the URL decoded form of `url` to `output`.
+ * A '%' that isn't followed by two hex digits is kept as is.
+ * 
+ * @param {std::string_view} url - The value to decode.
+ * @param {std::string&} output - Sink the decoded value is appended to, it is grown at most once.
+ */
+static void UrlDecodeInto(std::string_view url, std::string& output)
+{
+    const size_t firstEscape = UrlCodec::FindFirstEscape(url);
+
+    if (firstEscape == std::string_view::npos) 
     {
-        if (url[i] == '%') 
+        output.append(url.data(), url.size());
+        return;
+    }
+
+    /** Decoding never grows the value, size for the worst case and trim afterwards. */
+    const size_t offset = output.size();
+    output.resize(offset + url.size());
+
+    char* const begin = &output[offset];
+    char* cursor = std::copy(url.data(), url.data() + firstEscape, begin);
+
+    for (size_t i = firstEscape; i < url.size(); i++) 
+    {
+        const char c = url[i];
+
+        if (c == '%' && i + 2 < url.size())
         {
-            if (i + 2 < url.length() && std::isxdigit(url[i + 1]) && std::isxdigit(url[i + 2])) 
+            const int high = UrlCodec::hexValues[static_cast<unsigned char>(url[i + 1])];
+            const int low  = UrlCodec::hexValues[static_cast<unsigned char>(url[i + 2])];
+
+            if (high >= 0 && low >= 0)
             {
-                std::stringstream ss;
-                ss << std::hex << url.substr(i + 1, 2);
-                ss >> hexValue;
-                ch = static_cast<char>(hexValue);
-                decoded += ch;
-                i += 2; 
+                *cursor++ = static_cast<char>((high << 4) | low);
+                i += 2;
+                continue;
             }
-        } 
-        else if (url[i] == '+') { decoded += ' ';    } 
-        else                    { decoded += url[i]; }
+        }
+
+        *cursor++ = c == '+' ? ' ' : c;
     }
+
+    output.resize(cursor - output.data());
+}
+
+static std::string UrlDecode(std::string_view url)
+{
+    std::string decoded;
+    UrlDecodeInto(url, decoded);
     return decoded;
 }
 
-static const std::string UrlFromPath(const std::string baseAddress, const std::string path) 
+static const std::string UrlFromPath(const std::string& baseAddress, const std::string& path) 
 {
+    std::string url;
+    url.reserve(baseAddress.size() + path.size());
+    url.append(baseAddress);
+
     #if defined(__linux__) || defined(__APPLE__)
     {
-        return baseAddress + UrlEncode(path.substr(1));
+        UrlEncodeInto(std::string_view(path).substr(path.empty() ? 0 : 1), url);
     }
     #elif _WIN32
     {
-        return baseAddress + UrlEncode(path);
+        UrlEncodeInto(path, url);
     }
     #endif
+    return url;
 }
 
 static const std::string PathFromUrl(const std::string& path)
 {
+    std::string localPath;
+    localPath.reserve(path.size() + 1);
+
     #if defined(__linux__) || defined(__APPLE__)
     {
-        return "/" + UrlDecode(path);
-    }
-    #elif _WIN32
-    {
-        return UrlDecode(path);
+        localPath.push_back('/');
     }
     #endif
+
+    UrlDecodeInto(path, localPath);
+    return localPath;
 }
\ No newline at end of file
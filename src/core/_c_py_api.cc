@@ -41,6 +41,10 @@
 #include "plugin_logger.h"
 #include "encoding.h"
 #include "fvisible.h"
+#include "hook_profiler.h"
+#include "frontend_console.h"
+#include "cdp_passthrough.h"
+#include "env.h"
 
 std::shared_ptr<PluginLoader> g_pluginLoader;
 
@@ -62,69 +66,355 @@ MILLENNIUM PyObject* SetUserSettings(PyObject* self, PyObject* args)
     return NULL;
 }
 
-MILLENNIUM PyObject* CallFrontendMethod(PyObject* self, PyObject* args, PyObject* kwargs)
+/**
+ * @brief Converts a Python parameter list into frontend call parameters.
+ * 
+ * @param {PyObject*} parameterList - A list of bool, str or int values, may be NULL for no parameters.
+ * @param {std::vector<JavaScript::JsFunctionConstructTypes>&} params - Receives the converted parameters.
+ * @returns {bool} - false with a Python `TypeError` set if the list contains something else.
+ */
+static bool ParseFrontendParams(PyObject* parameterList, std::vector<JavaScript::JsFunctionConstructTypes>& params)
+{
+    if (parameterList == NULL || parameterList == Py_None)
+    {
+        return true;
+    }
+
+    if (!PyList_Check(parameterList))
+    {
+        PyErr_SetString(PyExc_TypeError, "params must be a list");
+        return false;
+    }
+
+    Py_ssize_t listSize = PyList_Size(parameterList);
+
+    for (Py_ssize_t i = 0; i < listSize; ++i) 
+    {
+        PyObject* listItem = PyList_GetItem(parameterList, i);
+        const std::string strValue  = PyUnicode_AsUTF8(PyObject_Str(listItem));
+        const std::string valueType = Py_TYPE(listItem)->tp_name;
+
+        try 
+        {
+            params.push_back({ strValue, typeMap.at(valueType) });
+        }
+        catch (const std::exception&) 
+        {
+            PyErr_SetString(PyExc_TypeError, "Millennium's IPC can only handle [bool, str, int]");
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Converts a timeout in seconds as passed from Python.
+ * @returns {std::optional<std::chrono::milliseconds>} - The timeout, or std::nullopt with a Python `ValueError` set.
+ */
+static std::optional<std::chrono::milliseconds> ParseEvaluateTimeout(double timeoutSeconds)
+{
+    if (!(timeoutSeconds > 0))
+    {
+        PyErr_SetString(PyExc_ValueError, "timeout must be a positive number of seconds");
+        return std::nullopt;
+    }
+
+    /** Keep absurdly large timeouts from overflowing the deadline computation, a day is effectively forever here. */
+    timeoutSeconds = std::min(timeoutSeconds, 86400.0);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<double>(timeoutSeconds));
+}
+
+/**
+ * @brief Get the name of the plugin whose interpreter is currently running.
+ * @returns {std::optional<std::string>} - The plugin name, or std::nullopt with a Python exception set.
+ */
+static std::optional<std::string> GetCallingPluginName()
+{
+    PyObject* globals = PyModule_GetDict(PyImport_AddModule("__main__"));
+    PyObject* pluginNameObj = PyRun_String("MILLENNIUM_PLUGIN_SECRET_NAME", Py_eval_input, globals, globals);
+
+    if (pluginNameObj == nullptr || PyErr_Occurred()) 
+    {
+        LOG_ERROR("error getting plugin name, can't make IPC request. this is likely a millennium bug.");
+        return std::nullopt;
+    }
+
+    return PyUnicode_AsUTF8(PyObject_Str(pluginNameObj));
+}
+
+struct FrontendMethodCall 
+{
+    std::string pluginName;
+    std::string methodName;
+    std::vector<JavaScript::JsFunctionConstructTypes> params;
+    std::chrono::milliseconds timeout;
+    bool binaryResults;
+};
+
+/**
+ * @brief Parses the arguments shared by call_frontend_method and call_frontend_method_async.
+ * 
+ * @param {PyObject*} args - Positional arguments, (method_name, params, timeout, binary).
+ * @param {PyObject*} kwargs - Keyword arguments, same names as above.
+ * @returns {std::optional<FrontendMethodCall>} - The call to make on the frontend, or std::nullopt with a Python exception set.
+ */
+static std::optional<FrontendMethodCall> ParseFrontendMethodCall(PyObject* args, PyObject* kwargs)
 {
     const char* methodName = NULL;
     PyObject* parameterList = NULL;
+    double timeoutSeconds = std::chrono::duration<double>(JavaScript::DEFAULT_EVALUATE_TIMEOUT).count();
+    int binaryResults = false;
 
-    static const char* keywordArgsList[] = { "method_name", "params", NULL };
+    static const char* keywordArgsList[] = { "method_name", "params", "timeout", "binary", NULL };
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|O", (char**)keywordArgsList, &methodName, &parameterList)) 
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|Odp", (char**)keywordArgsList, &methodName, &parameterList, &timeoutSeconds, &binaryResults)) 
     {
-        return NULL;
+        return std::nullopt;
     }
 
+    const auto timeout = ParseEvaluateTimeout(timeoutSeconds);
     std::vector<JavaScript::JsFunctionConstructTypes> params;
 
-    if (parameterList != NULL)
+    if (!timeout.has_value() || !ParseFrontendParams(parameterList, params)) 
     {
-        if (!PyList_Check(parameterList))
+        return std::nullopt;
+    }
+
+    const auto pluginName = GetCallingPluginName();
+
+    if (!pluginName.has_value()) 
+    {
+        return std::nullopt;
+    }
+
+    return FrontendMethodCall { *pluginName, methodName, std::move(params), *timeout, static_cast<bool>(binaryResults) };
+}
+
+/**
+ * @brief Calls a method on the calling plugin's frontend and blocks until it returns.
+ * Once the plugin called Millennium.ready(), calls made before its frontend is loaded wait for it (up to `timeout`).
+ * Frontends are only injected after every backend called ready(), so calls made before that (i.e from `_load`) 
+ * raise straight away if the frontend isn't loaded. Use call_frontend_method_async there, it always waits.
+ */
+MILLENNIUM PyObject* CallFrontendMethod(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    auto call = ParseFrontendMethodCall(args, kwargs);
+
+    if (!call.has_value()) 
+    {
+        return NULL;
+    }
+
+    return JavaScript::InvokeFrontendMethod(call->pluginName, call->methodName, std::move(call->params), call->timeout, call->binaryResults);
+}
+
+/**
+ * @brief Awaitable variant of call_frontend_method, returns an asyncio.Future bound to the running loop.
+ * Lets a backend keep many frontend calls in flight at once, i.e with asyncio.gather.
+ */
+MILLENNIUM PyObject* CallFrontendMethodAsync(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    auto call = ParseFrontendMethodCall(args, kwargs);
+
+    if (!call.has_value()) 
+    {
+        return NULL;
+    }
+
+    return JavaScript::InvokeFrontendMethodAsync(call->pluginName, call->methodName, std::move(call->params), call->timeout, call->binaryResults);
+}
+
+/**
+ * @brief Calls several frontend methods in order with a single round trip.
+ * 
+ * Takes `calls`, a list of (method_name, params) tuples (params may be omitted), an optional `timeout` covering the whole batch
+ * and `binary`, which returns ArrayBuffers and typed arrays as `bytes`.
+ * Returns a list with one entry per call, holding either its result or, for calls that threw, the exception they would have raised.
+ */
+MILLENNIUM PyObject* CallFrontendMethods(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    PyObject* callList = NULL;
+    double timeoutSeconds = std::chrono::duration<double>(JavaScript::DEFAULT_EVALUATE_TIMEOUT).count();
+    int binaryResults = false;
+
+    static const char* keywordArgsList[] = { "calls", "timeout", "binary", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|dp", (char**)keywordArgsList, &callList, &timeoutSeconds, &binaryResults)) 
+    {
+        return NULL;
+    }
+
+    const auto timeout = ParseEvaluateTimeout(timeoutSeconds);
+
+    if (!timeout.has_value()) 
+    {
+        return NULL;
+    }
+
+    if (!PyList_Check(callList))
+    {
+        PyErr_SetString(PyExc_TypeError, "calls must be a list of (method_name, params) tuples");
+        return NULL;
+    }
+
+    std::vector<JavaScript::FunctionCall> calls;
+    calls.reserve(PyList_Size(callList));
+
+    for (Py_ssize_t i = 0; i < PyList_Size(callList); ++i) 
+    {
+        PyObject* callItem = PyList_GetItem(callList, i);
+        const char* methodName = NULL;
+        PyObject* parameterList = NULL;
+
+        if (!PyTuple_Check(callItem) || !PyArg_ParseTuple(callItem, "s|O", &methodName, &parameterList)) 
         {
-            PyErr_SetString(PyExc_TypeError, "params must be a list");
+            PyErr_Clear();
+            PyErr_SetString(PyExc_TypeError, fmt::format("calls[{}] must be a (method_name, params) tuple", i).c_str());
             return NULL;
         }
 
-        Py_ssize_t listSize = PyList_Size(parameterList);
+        JavaScript::FunctionCall call { methodName, {} };
 
-        for (Py_ssize_t i = 0; i < listSize; ++i) 
+        if (!ParseFrontendParams(parameterList, call.params)) 
         {
-            PyObject* listItem = PyList_GetItem(parameterList, i);
-            const std::string strValue  = PyUnicode_AsUTF8(PyObject_Str(listItem));
-            const std::string valueType = Py_TYPE(listItem)->tp_name;
-
-            try 
-            {
-                params.push_back({ strValue, typeMap[valueType] });
-            }
-            catch (const std::exception&) 
-            {
-                PyErr_SetString(PyExc_TypeError, "Millennium's IPC can only handle [bool, str, int]");
-                return NULL;
-            }
+            return NULL;
         }
+        calls.push_back(std::move(call));
     }
 
-    PyObject* globals = PyModule_GetDict(PyImport_AddModule("__main__"));
-    PyObject* pluginNameObj = PyRun_String("MILLENNIUM_PLUGIN_SECRET_NAME", Py_eval_input, globals, globals);
+    const auto pluginName = GetCallingPluginName();
 
-    if (pluginNameObj == nullptr || PyErr_Occurred()) 
+    if (!pluginName.has_value()) 
     {
-        LOG_ERROR("error getting plugin name, can't make IPC request. this is likely a millennium bug.");
         return NULL;
     }
 
-    const std::string pluginName = PyUnicode_AsUTF8(PyObject_Str(pluginNameObj));
-    const std::string script = JavaScript::ConstructFunctionCall(pluginName.c_str(), methodName, params);
-
-    return JavaScript::EvaluateFromSocket(
-        // Check the the frontend code is actually loaded aside from SteamUI
-        fmt::format(
-            "if (typeof window !== 'undefined' && typeof window.MillenniumFrontEndError === 'undefined') {{ window.MillenniumFrontEndError = class MillenniumFrontEndError extends Error {{ constructor(message) {{ super(message); this.name = 'MillenniumFrontEndError'; }} }} }}"
-            "if (typeof PLUGIN_LIST === 'undefined' || !PLUGIN_LIST?.['{}']) throw new window.MillenniumFrontEndError('frontend not loaded yet!');\n\n{}", 
-            pluginName, 
-            script
-        ) 
-    );
+    if (calls.empty()) 
+    {
+        return PyList_New(0);
+    }
+
+    const std::string script = JavaScript::ConstructBatchedFunctionCall(pluginName->c_str(), calls, binaryResults);
+    return JavaScript::EvaluateBatchFromSocket(*pluginName, JavaScript::GuardFrontendLoaded(*pluginName, script), *timeout, binaryResults);
+}
+
+/**
+ * @brief Converts a dict of DevTools command parameters to JSON, see Python::PyObjectToJson.
+ * @returns {bool} - false with a Python exception set if the value isn't a JSON serializable dict.
+ */
+static bool ParseDevToolsParams(PyObject* paramsObj, nlohmann::json& params)
+{
+    params = nlohmann::json::object();
+
+    if (paramsObj == NULL || paramsObj == Py_None)
+    {
+        return true;
+    }
+
+    if (!PyDict_Check(paramsObj))
+    {
+        PyErr_SetString(PyExc_TypeError, "params must be a dict");
+        return false;
+    }
+
+    return Python::PyObjectToJson(paramsObj, params);
+}
+
+/**
+ * @brief Sends a raw DevTools protocol command over Millennium's browser connection.
+ * 
+ * Takes `method`, i.e "Page.captureScreenshot", optional `params` (a dict), `session_id` of an attached target 
+ * (the browser itself when omitted) and a `timeout` in seconds. Returns an awaitable resolving to the command's result.
+ */
+MILLENNIUM PyObject* SendDevToolsCommand(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    const char* method = NULL;
+    PyObject* paramsObj = NULL;
+    const char* sessionId = NULL;
+    double timeoutSeconds = std::chrono::duration<double>(JavaScript::DEFAULT_EVALUATE_TIMEOUT).count();
+
+    static const char* keywordArgsList[] = { "method", "params", "session_id", "timeout", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|Ozd", (char**)keywordArgsList, &method, &paramsObj, &sessionId, &timeoutSeconds)) 
+    {
+        return NULL;
+    }
+
+    nlohmann::json params;
+    const auto timeout = ParseEvaluateTimeout(timeoutSeconds);
+
+    if (!timeout.has_value() || !ParseDevToolsParams(paramsObj, params)) 
+    {
+        return NULL;
+    }
+
+    const auto pluginName = GetCallingPluginName();
+
+    if (!pluginName.has_value()) 
+    {
+        return NULL;
+    }
+
+    return JavaScript::SendBrowserCommandAsync(*pluginName, method, std::move(params), sessionId ? std::make_optional<std::string>(sessionId) : std::nullopt, *timeout);
+}
+
+/**
+ * @brief Subscribes to a DevTools protocol event on Millennium's browser connection.
+ * 
+ * Takes the event `method`, i.e "Network.responseReceived", a `callback` called as callback(params, session_id) on a 
+ * Millennium thread, and optionally the `session_id` to filter on. The event's domain must have been enabled with 
+ * send_devtools_command first. Returns a subscription id for unsubscribe_devtools_event.
+ */
+MILLENNIUM PyObject* SubscribeDevToolsEvent(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    const char* method = NULL;
+    PyObject* callback = NULL;
+    const char* sessionId = NULL;
+
+    static const char* keywordArgsList[] = { "method", "callback", "session_id", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO|z", (char**)keywordArgsList, &method, &callback, &sessionId)) 
+    {
+        return NULL;
+    }
+
+    if (!PyCallable_Check(callback)) 
+    {
+        PyErr_SetString(PyExc_TypeError, "callback must be callable");
+        return NULL;
+    }
+
+    const auto pluginName = GetCallingPluginName();
+
+    if (!pluginName.has_value()) 
+    {
+        return NULL;
+    }
+
+    const uint64_t subscriptionId = CdpPassthrough::get().Subscribe(*pluginName, method, sessionId ? std::make_optional<std::string>(sessionId) : std::nullopt, callback);
+    return PyLong_FromUnsignedLongLong(subscriptionId);
+}
+
+/**
+ * @brief Drops a subscription made with subscribe_devtools_event. Returns False if there was no such subscription.
+ */
+MILLENNIUM PyObject* UnsubscribeDevToolsEvent(PyObject* self, PyObject* args)
+{
+    unsigned long long subscriptionId = 0;
+
+    if (!PyArg_ParseTuple(args, "K", &subscriptionId)) 
+    {
+        return NULL;
+    }
+
+    const auto pluginName = GetCallingPluginName();
+
+    if (!pluginName.has_value()) 
+    {
+        return NULL;
+    }
+
+    return PyBool_FromLong(CdpPassthrough::get().Unsubscribe(*pluginName, subscriptionId));
 }
 
 MILLENNIUM PyObject* GetVersionInfo(PyObject* self, PyObject* args) 
@@ -195,6 +485,68 @@ MILLENNIUM PyObject* AddBrowserJs(PyObject* self, PyObject* args)
     return PyLong_FromLong((long)AddBrowserModule(args, HttpHookManager::TagTypes::JAVASCRIPT)); 
 }
 
+/**
+ * Registers a declarative rewrite rule applied to matching documents before they are rendered.
+ * 
+ * Python signature: add_browser_rewrite(match: str, content: str, url_pattern: str = ".*", action: str = "replace") -> int
+ * - `match` is a literal string (or anchor, i.e `</head>`) searched for in the document.
+ * - `action` is one of "replace", "before" or "after", deciding if `content` replaces each match or is inserted next to it.
+ * - A match overlapping Millennium's own injection after `<head>`, or an edit of a rule registered earlier, is skipped.
+ * 
+ * The returned module id can be passed to remove_browser_module.
+ */
+MILLENNIUM PyObject* AddBrowserRewrite(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    const char* match = NULL;
+    const char* content = NULL;
+    const char* urlPattern = ".*";
+    const char* action = "replace";
+
+    static const char* keywordArgsList[] = { "match", "content", "url_pattern", "action", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ss|ss", (char**)keywordArgsList, &match, &content, &urlPattern, &action)) 
+    {
+        return NULL;
+    }
+
+    static const std::map<std::string, HttpHookManager::RewriteAction> actionMap = {
+        { "replace", HttpHookManager::RewriteAction::REPLACE       },
+        { "before",  HttpHookManager::RewriteAction::INSERT_BEFORE },
+        { "after",   HttpHookManager::RewriteAction::INSERT_AFTER  }
+    };
+
+    const auto rewriteAction = actionMap.find(action);
+
+    if (rewriteAction == actionMap.end()) 
+    {
+        PyErr_SetString(PyExc_ValueError, "action must be one of 'replace', 'before' or 'after'");
+        return NULL;
+    }
+
+    if (std::string(match).empty()) 
+    {
+        PyErr_SetString(PyExc_ValueError, "match must not be empty");
+        return NULL;
+    }
+
+    std::regex urlRegex;
+
+    try 
+    {
+        urlRegex = std::regex(urlPattern);
+    } 
+    catch (const std::regex_error& e) 
+    {
+        PyErr_SetString(PyExc_ValueError, fmt::format("invalid url_pattern regex: {} ({})", urlPattern, e.what()).c_str());
+        return NULL;
+    }
+
+    g_hookedModuleId++;
+    HttpHookManager::get().AddRewriteRule({ urlRegex, match, content, rewriteAction->second, g_hookedModuleId });
+
+    return PyLong_FromLong((long)g_hookedModuleId);
+}
+
 /* 
 This portion of the API is undocumented but you can use it. 
 */
@@ -306,6 +658,8 @@ MILLENNIUM PyObject* EmitReadyMessage(PyObject* self, PyObject* args)
 
     const std::string pluginName = PyUnicode_AsUTF8(PyObject_Str(pluginNameObj));
 
+    JavaScript::MarkBackendReady(pluginName);
+
     CoInitializer::BackendCallbacks& backendHandler = CoInitializer::BackendCallbacks::getInstance();
     backendHandler.BackendLoaded({ pluginName, CoInitializer::BackendCallbacks::BACKEND_LOAD_SUCCESS });
 
@@ -319,11 +673,37 @@ MILLENNIUM PyObject* GetPluginLogs(PyObject* self, PyObject* args)
 
     std::vector<SettingsStore::PluginTypeSchema> plugins = settingsStore->ParseAllPlugins();
 
-    for (auto& logger : g_loggerList) 
+    /** Backend loggers first, followed by plugins that have only logged from their frontend. */
+    std::vector<std::string> pluginNames;
+    std::vector<BackendLogger*> loggers;
+    {
+        std::lock_guard<std::mutex> lock(g_loggerListMutex);
+        loggers = g_loggerList;
+    }
+
+    for (auto& logger : loggers) 
+    {
+        pluginNames.push_back(logger->GetPluginName(false));
+    }
+
+    for (auto& pluginName : FrontendConsole::get().GetPluginNames()) 
+    {
+        if (std::find(pluginNames.begin(), pluginNames.end(), pluginName) == pluginNames.end()) 
+        {
+            pluginNames.push_back(pluginName);
+        }
+    }
+
+    for (size_t i = 0; i < pluginNames.size(); i++) 
     {
         nlohmann::json logDataItem;
 
-        for (auto [message, logLevel] : logger->CollectLogs()) 
+        std::vector<BackendLogger::LogEntry> entries = i < loggers.size() ? loggers[i]->CollectLogs() : std::vector<BackendLogger::LogEntry>();
+        std::vector<BackendLogger::LogEntry> frontendEntries = FrontendConsole::get().CollectLogs(pluginNames[i]);
+
+        entries.insert(entries.end(), std::make_move_iterator(frontendEntries.begin()), std::make_move_iterator(frontendEntries.end()));
+
+        for (auto [message, logLevel] : entries) 
         {
             logDataItem.push_back({
                 { "message", Base64Encode(message) },
@@ -331,11 +711,11 @@ MILLENNIUM PyObject* GetPluginLogs(PyObject* self, PyObject* args)
             });
         }
 
-        std::string pluginName = logger->GetPluginName(false);
+        std::string pluginName = pluginNames[i];
 
         for (auto& plugin : plugins) 
         {
-            if (plugin.pluginJson.contains("name") && plugin.pluginJson["name"] == logger->GetPluginName(false)) 
+            if (plugin.pluginJson.contains("name") && plugin.pluginJson["name"] == pluginNames[i]) 
             {
                 pluginName = plugin.pluginJson.value("common_name", pluginName);
                 break;
@@ -357,6 +737,60 @@ MILLENNIUM PyObject* GetPluginLogs(PyObject* self, PyObject* args)
     return PyUnicode_FromString(logData.dump().c_str());
 }
 
+/**
+ * @brief Turn recording of interception latencies on or off, it is off by default.
+ * @param {bool} enabled - Whether intercepted requests should be profiled.
+ */
+MILLENNIUM PyObject* SetHookProfiling(PyObject* self, PyObject* args) 
+{
+    int isEnabled = 0;
+
+    if (!PyArg_ParseTuple(args, "p", &isEnabled)) 
+    {
+        return NULL;
+    }
+
+    HookProfiler::get().SetEnabled(isEnabled);
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Get the interception latency histograms of the HttpHookManager, grouped by URL pattern and stage.
+ * Only requests intercepted while profiling is enabled (see set_hook_profiling) are recorded.
+ * @returns {str} - JSON encoded histograms, see HookProfiler::GetHistograms
+ */
+MILLENNIUM PyObject* GetHookProfile(PyObject* self, PyObject* args) 
+{
+    return PyUnicode_FromString(HookProfiler::get().GetHistograms().dump().c_str());
+}
+
+/**
+ * @brief Write the recent interception waterfalls as a chrome://tracing compatible file.
+ * @param {str} path - Optional destination, defaults to hook_trace.json in the Millennium logs directory.
+ * @returns {str} - The path the trace was written to.
+ */
+MILLENNIUM PyObject* DumpHookTrace(PyObject* self, PyObject* args) 
+{
+    const char* tracePath = nullptr;
+
+    if (!PyArg_ParseTuple(args, "|s", &tracePath)) 
+    {
+        return NULL;
+    }
+
+    const std::string outputPath = tracePath ? tracePath : (std::filesystem::path(GetEnv("MILLENNIUM__LOGS_PATH")) / "hook_trace.json").string();
+    std::ofstream outputFile(outputPath);
+
+    if (!outputFile.is_open()) 
+    {
+        PyErr_SetString(PyExc_OSError, fmt::format("Failed to open '{}' for writing.", outputPath).c_str());
+        return NULL;
+    }
+
+    outputFile << HookProfiler::get().GetChromeTrace().dump();
+    return PyUnicode_FromString(outputPath.c_str());
+}
+
 // Helper to convert month abbreviation to number
 std::string getMonthNumber(const std::string& monthAbbr) 
 {
@@ -411,7 +845,9 @@ MILLENNIUM PyMethodDef* GetMillenniumModule()
         { "add_browser_css",       AddBrowserCss,                   METH_VARARGS, NULL },
         /** Add a JavaScript file to the browser webkit hook list */
         { "add_browser_js",        AddBrowserJs,                    METH_VARARGS, NULL },
-        /** Remove a CSS or JavaScript file, passing the ModuleID provided from add_browser_js/css */
+        /** Rewrite matching documents before they render, i.e insert markup after an anchor. Applied natively without running JavaScript. */
+        { "add_browser_rewrite",   (PyCFunction)AddBrowserRewrite,  METH_VARARGS | METH_KEYWORDS, NULL },
+        /** Remove a CSS or JavaScript file or a rewrite rule, passing the ModuleID provided from add_browser_js/css/rewrite */
         { "remove_browser_module", RemoveBrowserModule,             METH_VARARGS, NULL },
 
         { "get_user_settings",     GetUserSettings,                 METH_NOARGS,  NULL },
@@ -424,9 +860,28 @@ MILLENNIUM PyMethodDef* GetMillenniumModule()
         { "get_install_path",      GetInstallPath,                  METH_NOARGS,  NULL },
         /** Get all the current stored logs from all loaded and previously loaded plugins during this instance */
         { "get_plugin_logs" ,      GetPluginLogs,                   METH_NOARGS, NULL },
+        /** Turn interception latency profiling on or off, it is off by default */
+        { "set_hook_profiling",    SetHookProfiling,                METH_VARARGS, NULL },
+        /** Get per URL pattern latency histograms of every intercepted request stage */
+        { "get_hook_profile",      GetHookProfile,                  METH_NOARGS,  NULL },
+        /** Write the recent intercepted request waterfalls to a chrome://tracing file, returns the file path */
+        { "dump_hook_trace",       DumpHookTrace,                   METH_VARARGS, NULL },
 
-        /** Call a JavaScript method on the frontend. */
+        /** 
+         * Call a JavaScript method on the frontend. Results are returned as native Python values, pass binary=True to receive ArrayBuffers and typed arrays as bytes. 
+         * Waits for the frontend to load only after the plugin called ready(), before that it raises if the frontend isn't loaded yet.
+         */
         { "call_frontend_method",  (PyCFunction)CallFrontendMethod, METH_VARARGS | METH_KEYWORDS, NULL },
+        /** Same as call_frontend_method, but returns an awaitable instead of blocking the calling thread. */
+        { "call_frontend_method_async", (PyCFunction)CallFrontendMethodAsync, METH_VARARGS | METH_KEYWORDS, NULL },
+        /** Call several JavaScript methods on the frontend in order with a single round trip, returns every result (or exception) in a list. */
+        { "call_frontend_methods", (PyCFunction)CallFrontendMethods, METH_VARARGS | METH_KEYWORDS, NULL },
+        /** Send a raw DevTools protocol command over Millennium's browser connection, returns an awaitable for its result. */
+        { "send_devtools_command", (PyCFunction)SendDevToolsCommand, METH_VARARGS | METH_KEYWORDS, NULL },
+        /** Call a function whenever the browser emits a DevTools protocol event, returns a subscription id. */
+        { "subscribe_devtools_event", (PyCFunction)SubscribeDevToolsEvent, METH_VARARGS | METH_KEYWORDS, NULL },
+        /** Stop a subscription made with subscribe_devtools_event. */
+        { "unsubscribe_devtools_event", UnsubscribeDevToolsEvent,   METH_VARARGS, NULL },
         /** 
          * @note Internal Use Only 
          * Used to toggle the status of a plugin, used in the Millennium settings page.
@@ -30,8 +30,11 @@
 
 #include "ffi.h"
 #include "co_spawn.h"
+#include "backend_worker.h"
 #include <iostream>
 #include <tuple>
+#include <string_view>
+#include <unordered_map>
 #include "plugin_logger.h"
 #include "fvisible.h"
 
@@ -97,6 +100,275 @@ MILLENNIUM std::tuple<std::string, std::string> Python::ActiveExceptionInformati
 }
 
 
+static PyObject* JsonToPyObject(const json& value, Python::JsonObjectHook objectHook, int depth)
+{
+    if (depth > Python::MAX_JSON_DEPTH) 
+    {
+        PyErr_SetString(PyExc_RecursionError, "JSON value is nested too deeply to convert");
+        return NULL;
+    }
+
+    switch (value.type())
+    {
+        case json::value_t::null:            Py_RETURN_NONE;
+        case json::value_t::boolean:         return PyBool_FromLong(value.get<bool>());
+        case json::value_t::number_integer:  return PyLong_FromLongLong(value.get<int64_t>());
+        case json::value_t::number_unsigned: return PyLong_FromUnsignedLongLong(value.get<uint64_t>());
+        case json::value_t::number_float:    return PyFloat_FromDouble(value.get<double>());
+        case json::value_t::string: 
+        {
+            const auto& str = value.get_ref<const std::string&>();
+            return PyUnicode_FromStringAndSize(str.data(), static_cast<Py_ssize_t>(str.size()));
+        }
+        case json::value_t::binary: 
+        {
+            const auto& bytes = value.get_binary();
+            return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(bytes.data()), static_cast<Py_ssize_t>(bytes.size()));
+        }
+        case json::value_t::array: 
+        {
+            PyObject* list = PyList_New(static_cast<Py_ssize_t>(value.size()));
+            Py_ssize_t index = 0;
+
+            for (const auto& entry : value) 
+            {
+                PyObject* item = list ? JsonToPyObject(entry, objectHook, depth + 1) : NULL;
+
+                if (item == NULL) 
+                {
+                    Py_XDECREF(list);
+                    return NULL;
+                }
+                PyList_SET_ITEM(list, index++, item);
+            }
+            return list;
+        }
+        case json::value_t::object: 
+        {
+            PyObject* hooked = NULL;
+
+            if (objectHook != nullptr && objectHook(value, hooked)) 
+            {
+                return hooked;
+            }
+
+            PyObject* dict = PyDict_New();
+
+            for (const auto& [key, entry] : value.items()) 
+            {
+                PyObject* pyKey = dict ? PyUnicode_FromStringAndSize(key.data(), static_cast<Py_ssize_t>(key.size())) : NULL;
+                PyObject* item  = pyKey ? JsonToPyObject(entry, objectHook, depth + 1) : NULL;
+
+                if (item == NULL || PyDict_SetItem(dict, pyKey, item) < 0) 
+                {
+                    Py_XDECREF(item);
+                    Py_XDECREF(pyKey);
+                    Py_XDECREF(dict);
+                    return NULL;
+                }
+                Py_DECREF(item);
+                Py_DECREF(pyKey);
+            }
+            return dict;
+        }
+        default: 
+        {
+            Py_RETURN_NONE;
+        }
+    }
+}
+
+/**
+ * Converts a JSON value to the matching Python value, without going through the json module.
+ *
+ * @param {const nlohmann::json&} value - The value to convert.
+ * @param {Python::JsonObjectHook} objectHook - Optional, gets the first say on every object, i.e to decode wrapped values.
+ * @returns {PyObject*} - A new reference, or NULL with a Python exception set.
+ *
+ * null → None, booleans → bool, integers → int, other numbers → float, strings → str, binary → bytes, arrays → list and objects → dict.
+ */
+MILLENNIUM PyObject* Python::JsonToPyObject(const json& value, Python::JsonObjectHook objectHook)
+{
+    return ::JsonToPyObject(value, objectHook, 0);
+}
+
+/**
+ * @brief Get the key a dict key is stored under in JSON, following the rules of json.dumps.
+ * @returns {bool} - false with a Python `TypeError` set for keys JSON can't represent.
+ */
+static bool PyObjectToJsonKey(PyObject* key, std::string& jsonKey)
+{
+    if (PyUnicode_Check(key)) 
+    {
+        Py_ssize_t size = 0;
+        const char* utf8 = PyUnicode_AsUTF8AndSize(key, &size);
+
+        if (utf8 == NULL) 
+        {
+            return false;
+        }
+        jsonKey.assign(utf8, size);
+        return true;
+    }
+
+    if (key == Py_True || key == Py_False || key == Py_None) 
+    {
+        jsonKey = key == Py_None ? "null" : key == Py_True ? "true" : "false";
+        return true;
+    }
+
+    if (PyLong_Check(key) || PyFloat_Check(key)) 
+    {
+        PyObject* representation = PyLong_Check(key) ? PyObject_Str(key) : PyObject_Repr(key);
+        const char* utf8 = representation ? PyUnicode_AsUTF8(representation) : NULL;
+
+        if (utf8 != NULL) 
+        {
+            jsonKey = utf8;
+        }
+        Py_XDECREF(representation);
+        return utf8 != NULL;
+    }
+
+    PyErr_Format(PyExc_TypeError, "keys must be str, int, float, bool or None, not %.100s", Py_TYPE(key)->tp_name);
+    return false;
+}
+
+static bool PyObjectToJson(PyObject* object, json& value, int depth)
+{
+    if (depth > Python::MAX_JSON_DEPTH) 
+    {
+        PyErr_SetString(PyExc_RecursionError, "object is nested too deeply to convert to JSON (circular reference?)");
+        return false;
+    }
+
+    if (object == Py_None) 
+    {
+        value = nullptr;
+    }
+    else if (PyBool_Check(object)) 
+    {
+        value = object == Py_True;
+    }
+    else if (PyLong_Check(object)) 
+    {
+        int overflow = 0;
+        const long long signedValue = PyLong_AsLongLongAndOverflow(object, &overflow);
+
+        if (overflow == 0) 
+        {
+            if (signedValue == -1 && PyErr_Occurred()) return false;
+            value = static_cast<int64_t>(signedValue);
+            return true;
+        }
+
+        const unsigned long long unsignedValue = overflow > 0 ? PyLong_AsUnsignedLongLong(object) : static_cast<unsigned long long>(-1);
+
+        if (overflow > 0 && !PyErr_Occurred()) 
+        {
+            value = static_cast<uint64_t>(unsignedValue);
+            return true;
+        }
+
+        /** Wider than 64 bits, the receiving end (JavaScript) can't represent it exactly either. */
+        PyErr_Clear();
+        const double doubleValue = PyLong_AsDouble(object);
+
+        if (doubleValue == -1.0 && PyErr_Occurred()) return false;
+        value = doubleValue;
+    }
+    else if (PyFloat_Check(object)) 
+    {
+        value = PyFloat_AS_DOUBLE(object);
+    }
+    else if (PyUnicode_Check(object)) 
+    {
+        Py_ssize_t size = 0;
+        const char* utf8 = PyUnicode_AsUTF8AndSize(object, &size);
+
+        if (utf8 == NULL) return false;
+        value = std::string(utf8, size);
+    }
+    else if (PyBytes_Check(object)) 
+    {
+        const auto* data = reinterpret_cast<const uint8_t*>(PyBytes_AS_STRING(object));
+        value = json::binary(std::vector<uint8_t>(data, data + PyBytes_GET_SIZE(object)));
+    }
+    else if (PyByteArray_Check(object)) 
+    {
+        const auto* data = reinterpret_cast<const uint8_t*>(PyByteArray_AS_STRING(object));
+        value = json::binary(std::vector<uint8_t>(data, data + PyByteArray_GET_SIZE(object)));
+    }
+    else if (PyList_Check(object) || PyTuple_Check(object)) 
+    {
+        const bool isList = PyList_Check(object);
+        const Py_ssize_t size = isList ? PyList_GET_SIZE(object) : PyTuple_GET_SIZE(object);
+
+        value = json::array();
+        value.get_ref<json::array_t&>().reserve(static_cast<size_t>(size));
+
+        /** Sizes are re-read every iteration, a list may be mutated by Python code run further down. */
+        for (Py_ssize_t i = 0; i < (isList ? PyList_GET_SIZE(object) : size); i++) 
+        {
+            PyObject* item = isList ? PyList_GET_ITEM(object, i) : PyTuple_GET_ITEM(object, i);
+            json entry;
+
+            Py_INCREF(item);
+            const bool converted = PyObjectToJson(item, entry, depth + 1);
+            Py_DECREF(item);
+
+            if (!converted) return false;
+            value.push_back(std::move(entry));
+        }
+    }
+    else if (PyDict_Check(object)) 
+    {
+        PyObject* key;
+        PyObject* item;
+        Py_ssize_t position = 0;
+
+        value = json::object();
+
+        while (PyDict_Next(object, &position, &key, &item)) 
+        {
+            std::string jsonKey;
+            json entry;
+
+            /** Converting a key or value may run Python code (str() of an int subclass), keep both alive meanwhile. */
+            Py_INCREF(key);
+            Py_INCREF(item);
+            const bool converted = PyObjectToJsonKey(key, jsonKey) && PyObjectToJson(item, entry, depth + 1);
+            Py_DECREF(item);
+            Py_DECREF(key);
+
+            if (!converted) return false;
+            value[jsonKey] = std::move(entry);
+        }
+    }
+    else 
+    {
+        PyErr_Format(PyExc_TypeError, "Object of type %.100s is not JSON serializable", Py_TYPE(object)->tp_name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Converts a Python value to JSON, without going through the json module.
+ *
+ * @param {PyObject*} object - The value to convert.
+ * @param {nlohmann::json&} value - Receives the converted value.
+ * @returns {bool} - false with a Python exception set if the value (or something in it) has no JSON representation.
+ *
+ * Accepts what json.dumps accepts (dict, list, tuple, str, int, float, bool, None) with the same key rules, plus bytes 
+ * and bytearray, which become binary values. Integers wider than 64 bits are converted to float.
+ */
+MILLENNIUM bool Python::PyObjectToJson(PyObject* object, json& value)
+{
+    return ::PyObjectToJson(object, value, 0);
+}
+
 /**
 * Converts a Python object to an EvalResult with appropriate type classification and string representation.
 * 
@@ -161,39 +433,12 @@ Python::EvalResult PyObjectCastEvalResult(PyObject* obj)
     else if (PyList_Check(obj) || PyTuple_Check(obj) || PyDict_Check(obj)) 
     {
         result.type = Python::Types::JSON;
-        
-        PyObject* jsonModule = PyImport_ImportModule("json");
-        if (jsonModule) 
+        json value;
+
+        if (Python::PyObjectToJson(obj, value)) 
         {
-            PyObject* dumpsFunction = PyObject_GetAttrString(jsonModule, "dumps");
-            if (dumpsFunction) 
-            {
-                PyObject* json_str = PyObject_CallFunction(dumpsFunction, "O", obj);
-                if (json_str && PyUnicode_Check(json_str)) 
-                {
-                    const char* utf8JsonStr = PyUnicode_AsUTF8(json_str);
-                    result.plain = utf8JsonStr ? utf8JsonStr : "{}";
-                } 
-                else 
-                {
-                    PyErr_Clear();
-                    PyObject* representationObj = PyObject_Repr(obj);
-                    if (representationObj) 
-                    {
-                        const char* representationString = PyUnicode_AsUTF8(representationObj);
-                        result.plain = representationString ? representationString : "{}";
-                        Py_DECREF(representationObj);
-                    }
-                    else 
-                    {
-                        result.plain = "{}";
-                    }
-                }
-                Py_XDECREF(json_str);
-                Py_DECREF(dumpsFunction);
-            }
-            Py_DECREF(jsonModule);
-        } 
+            result.plain = value.dump(-1, ' ', false, json::error_handler_t::replace);
+        }
         else 
         {
             PyErr_Clear();
@@ -206,6 +451,7 @@ Python::EvalResult PyObjectCastEvalResult(PyObject* obj)
             } 
             else 
             {
+                PyErr_Clear();
                 result.plain = "{}";
             }
         }
@@ -234,135 +480,289 @@ Python::EvalResult PyObjectCastEvalResult(PyObject* obj)
     return result;
 }
 
-/** 
- *  Resolves a dotted attribute path to a Python object.
+/**
+ * Backend method names parsed into the attribute lookups they stand for, one cache per sub-interpreter.
  * 
- * @param dottedPath The dotted path string, e.g., "module.submodule.function".
- * @return A PyObject* representing the resolved attribute, or nullptr if not found.
+ * The cache is stored as a capsule on the interpreter's state dict, so it is only ever touched with that 
+ * interpreter's GIL held, and is released along with the interpreter when the plugin is stopped or reloaded.
+ * Only the parsed path is cached, not the callable it leads to. Every call looks up the root in `__main__` and 
+ * each attribute again, so reloading a module (i.e importlib.reload) or rebinding an attribute is picked up by the next call.
  */
-PyObject* resolveDottedAttribute(const std::string& dottedPath) 
+class MethodPathCache
 {
-    std::vector<std::string> parts;
-    std::stringstream ss(dottedPath);
-    std::string part;
-    
-    while (std::getline(ss, part, '.')) 
+private:
+    static constexpr const char* CAPSULE_NAME = "millennium.method_paths";
+
+    struct MethodPath
+    {
+        PyObject* rootName;                     /** Key of the root object in `__main__`'s globals. */
+        std::vector<PyObject*> attributeNames;  /** Interned names of the attributes looked up from the root, in order. */
+    };
+
+    PyObject* m_globals;
+    std::unordered_map<std::string, MethodPath> m_paths;
+
+    explicit MethodPathCache(PyObject* globals) : m_globals(Py_NewRef(globals)) { }
+
+    static void Release(MethodPath& path)
     {
-        parts.push_back(part);
+        Py_XDECREF(path.rootName);
+        for (PyObject* attributeName : path.attributeNames) 
+        {
+            Py_DECREF(attributeName);
+        }
     }
-    
-    if (parts.empty()) 
+
+    static void DestroyCapsule(PyObject* capsule)
     {
-        return nullptr;
+        delete static_cast<MethodPathCache*>(PyCapsule_GetPointer(capsule, CAPSULE_NAME));
     }
-    
-    PyObject* current = PyObject_GetAttrString(PyImport_AddModule("__main__"), parts[0].c_str());
-    if (!current) 
+
+    /**
+     * @brief Split a dotted attribute path, e.g "Plugin.method", into interned names.
+     * 
+     * @param {std::string_view} dottedPath - The path to parse.
+     * @param {MethodPath&} path - Receives new references to the root key and the attribute names.
+     * @returns {bool} - False with a Python exception set if a name couldn't be created.
+     */
+    static bool ParseDottedPath(std::string_view dottedPath, MethodPath& path)
     {
-        return nullptr;
+        const size_t rootLength = std::min(dottedPath.find('.'), dottedPath.size());
+
+        path.rootName = PyUnicode_FromStringAndSize(dottedPath.data(), rootLength);
+        if (!path.rootName) 
+        {
+            return false;
+        }
+        PyUnicode_InternInPlace(&path.rootName);
+
+        for (size_t offset = rootLength; offset < dottedPath.size();) 
+        {
+            const size_t begin = offset + 1;
+            const size_t length = std::min(dottedPath.find('.', begin), dottedPath.size()) - begin;
+
+            PyObject* attributeName = PyUnicode_FromStringAndSize(dottedPath.data() + begin, length);
+            if (!attributeName) 
+            {
+                return false;
+            }
+            PyUnicode_InternInPlace(&attributeName);
+
+            path.attributeNames.push_back(attributeName);
+            offset = begin + length;
+        }
+        return true;
     }
-    
-    for (size_t i = 1; i < parts.size(); ++i) 
+
+public:
+    ~MethodPathCache()
     {
-        PyObject* next = PyObject_GetAttrString(current, parts[i].c_str());
-        Py_DECREF(current);
-        if (!next) 
+        for (auto& [methodName, path] : m_paths) 
+        {
+            Release(path);
+        }
+        Py_DECREF(m_globals);
+    }
+
+    /**
+     * @brief Get the cache belonging to the interpreter of the calling thread, creating it on first use.
+     * @note The calling thread must hold the interpreter's GIL.
+     * 
+     * @returns {MethodPathCache*} - The cache, or nullptr (with no exception set) if it couldn't be created.
+     */
+    static MethodPathCache* ForCurrentInterpreter()
+    {
+        PyObject* interpreterDict = PyInterpreterState_GetDict(PyInterpreterState_Get());
+        if (!interpreterDict) 
+        {
+            return nullptr;
+        }
+
+        if (PyObject* capsule = PyDict_GetItemString(interpreterDict, CAPSULE_NAME)) 
+        {
+            return static_cast<MethodPathCache*>(PyCapsule_GetPointer(capsule, CAPSULE_NAME));
+        }
+
+        PyObject* mainModule = PyImport_AddModule("__main__");
+        if (!mainModule) 
+        {
+            PyErr_Clear();
+            return nullptr;
+        }
+
+        MethodPathCache* cache = new MethodPathCache(PyModule_GetDict(mainModule));
+        PyObject* capsule = PyCapsule_New(cache, CAPSULE_NAME, DestroyCapsule);
+
+        if (!capsule) 
         {
+            PyErr_Clear();
+            delete cache;
             return nullptr;
         }
-        current = next;
+
+        const int setResult = PyDict_SetItemString(interpreterDict, CAPSULE_NAME, capsule);
+        Py_DECREF(capsule);
+
+        if (setResult < 0) 
+        {
+            /** The capsule owned the cache and has already been released. */
+            PyErr_Clear();
+            return nullptr;
+        }
+        return cache;
     }
-    
-    return current;
-}
+
+    /**
+     * @brief Get the callable a dotted method name currently refers to.
+     * 
+     * @param {std::string} methodName - The dotted method name, e.g "Plugin.method".
+     * @returns {PyObject*} - A new reference to the callable, or nullptr with a Python exception set.
+     */
+    PyObject* Resolve(const std::string& methodName)
+    {
+        auto it = m_paths.find(methodName);
+
+        if (it == m_paths.end()) 
+        {
+            MethodPath path { nullptr, {} };
+
+            if (!ParseDottedPath(methodName, path)) 
+            {
+                Release(path);
+                return nullptr;
+            }
+            it = m_paths.emplace(methodName, std::move(path)).first;
+        }
+
+        const MethodPath& path = it->second;
+        PyObject* root = PyDict_GetItemWithError(m_globals, path.rootName);
+
+        if (!root) 
+        {
+            if (!PyErr_Occurred()) 
+            {
+                PyErr_Format(PyExc_AttributeError, "module '__main__' has no attribute '%U'", path.rootName);
+            }
+            return nullptr;
+        }
+
+        PyObject* callable = Py_NewRef(root);
+
+        for (PyObject* attributeName : path.attributeNames) 
+        {
+            PyObject* next = PyObject_GetAttr(callable, attributeName);
+            Py_DECREF(callable);
+
+            if (!next) 
+            {
+                return nullptr;
+            }
+            callable = next;
+        }
+
+        if (!PyCallable_Check(callable)) 
+        {
+            PyErr_Format(PyExc_TypeError, "'%s' is not callable", methodName.c_str());
+            Py_DECREF(callable);
+            return nullptr;
+        }
+        return callable;
+    }
+};
 
 /** 
  * Calls a Python function with the provided JSON data.
+ * The arguments are passed as keywords through the vectorcall protocol, no intermediate tuple or dict is built.
  * 
  * @param jsonData The JSON object containing the method name and arguments.
  * @return A PyObject* representing the result of the function call, or nullptr on failure.
  */
 PyObject* callPythonFunctionWithJson(const nlohmann::json& jsonData) 
 {
-    std::string methodName = jsonData["methodName"];
-    
-    PyObject* pFunc = resolveDottedAttribute(methodName);
-    if (!pFunc || !PyCallable_Check(pFunc)) 
+    const std::string methodName = jsonData["methodName"];
+    MethodPathCache* methodPaths = MethodPathCache::ForCurrentInterpreter();
+
+    if (!methodPaths) 
     {
-        std::cerr << "Function " << methodName << " not found or not callable" << std::endl;
-        Py_XDECREF(pFunc);
+        std::cerr << "Failed to get the method path cache while resolving " << methodName << std::endl;
         return nullptr;
     }
-    
-    PyObject* pKwargs = PyDict_New();
-    if (!pKwargs) 
+
+    PyObject* pFunc = methodPaths->Resolve(methodName);
+    if (!pFunc) 
     {
-        Py_DECREF(pFunc);
+        std::cerr << "Function " << methodName << " not found or not callable" << std::endl;
         return nullptr;
     }
-    
-    if (jsonData.contains("argumentList") && !jsonData["argumentList"].is_null()) 
+
+    /** Slot 0 is left free so callees are allowed to use it (PY_VECTORCALL_ARGUMENTS_OFFSET). */
+    std::vector<PyObject*> callStack(1, nullptr);
+    PyObject* pKeywordNames = nullptr;
+
+    const auto cleanup = [&]() 
     {
-        auto argumentList = jsonData["argumentList"];
-        
-        for (auto& [key, value] : argumentList.items()) 
+        for (size_t i = 1; i < callStack.size(); i++) 
         {
-            PyObject* pValue = nullptr;
-            
-            if      (value.is_string())         pValue = PyUnicode_FromString(value.get<std::string>().c_str());
-            else if (value.is_number_integer()) pValue = PyLong_FromLong(value.get<int>());
-            else if (value.is_number_float())   pValue = PyFloat_FromDouble(value.get<double>());
-            else if (value.is_boolean())        pValue = PyBool_FromLong(value.get<bool>() ? 1 : 0);
-            
+            Py_DECREF(callStack[i]);
+        }
+        Py_XDECREF(pKeywordNames);
+        Py_DECREF(pFunc);
+    };
 
-            else if (value.is_null()) 
+    if (jsonData.contains("argumentList") && !jsonData["argumentList"].is_null() && !jsonData["argumentList"].empty()) 
+    {
+        const auto& argumentList = jsonData["argumentList"];
+
+        pKeywordNames = PyTuple_New(static_cast<Py_ssize_t>(argumentList.size()));
+        if (!pKeywordNames) 
+        {
+            cleanup();
+            return nullptr;
+        }
+
+        callStack.reserve(argumentList.size() + 1);
+        Py_ssize_t index = 0;
+
+        for (auto& [key, value] : argumentList.items()) 
+        {
+            PyObject* pKey = PyUnicode_FromStringAndSize(key.data(), static_cast<Py_ssize_t>(key.size()));
+            if (!pKey) 
             {
-                pValue = Py_None;
-                Py_INCREF(Py_None);
+                cleanup();
+                return nullptr;
             }
+            PyTuple_SET_ITEM(pKeywordNames, index++, pKey);
 
-            if (pValue) 
+            PyObject* pValue = Python::JsonToPyObject(value);
+            if (!pValue) 
             {
-                if (PyDict_SetItemString(pKwargs, key.c_str(), pValue) < 0) 
-                {
-                    Py_DECREF(pValue);
-                    Py_DECREF(pKwargs);
-                    Py_DECREF(pFunc);
-                    return nullptr;
-                }
-                Py_DECREF(pValue);
+                cleanup();
+                return nullptr;
             }
+            callStack.push_back(pValue);
         }
     }
 
-    PyObject* pArgs = PyTuple_New(0);
-    PyObject* pResult = PyObject_Call(pFunc, pArgs, pKwargs);
-    
-    // Cleanup
-    Py_DECREF(pArgs);
-    Py_DECREF(pKwargs);
-    Py_DECREF(pFunc);
-    
+    PyObject* pResult = PyObject_Vectorcall(pFunc, callStack.data() + 1, PY_VECTORCALL_ARGUMENTS_OFFSET, pKeywordNames);
+
+    cleanup();
     return pResult;
 }
 
 /**
- * Locks the Python Global Interpreter Lock (GIL) for the specified plugin's thread state
- * and evaluates the given Python script.
+ * Invokes a backend method of the specified plugin on the plugin's executor (see PluginExecutor), 
+ * or in its worker process if the plugin runs out of process (see BackendWorker).
  *
- * @param {std::string} pluginName - The name of the plugin requesting script evaluation.
- * @param {std::string} script - The Python script to execute.
+ * @param {std::string} pluginName - The name of the plugin that owns the method.
+ * @param {nlohmann::json} functionCall - The call, containing `methodName` and optionally `argumentList`.
  * @returns {Python::EvalResult} - The result of the evaluation, containing the evaluated value as a string and its type.
  *
- * This function retrieves the Python thread state associated with the given plugin and locks the GIL.
- * If the thread state cannot be obtained, an error is logged, and an error result is returned.
- * The script is then executed via `EvaluatePython()`, and after execution, the GIL is released.
+ * The call is queued behind any other work for the same plugin and this function blocks until it has run, 
+ * calls into one plugin are therefore serialized in the order they arrived.
  *
  * Possible error conditions:
- * - If the thread state cannot be retrieved, an error is logged and returned.
- * - If the thread state is null after acquiring the GIL, an error is logged and returned.
- *
- * The function ensures that the GIL is properly acquired and released before and after execution.
+ * - If the plugin has no running executor (it crashed, exited early or is shutting down), an error is logged and returned.
+ * - If the `__main__` module can't be fetched, an error is logged and returned.
  */
 MILLENNIUM Python::EvalResult Python::LockGILAndInvokeMethod(std::string pluginName, nlohmann::json functionCall)
 {
@@ -374,73 +774,51 @@ MILLENNIUM Python::EvalResult Python::LockGILAndInvokeMethod(std::string pluginN
         return { "false", Boolean };
     }
 
-    auto result = PythonManager::GetInstance().GetPythonThreadStateFromName(pluginName);
+    std::optional<EvalResult> response;
 
-    if (!result.has_value()) 
+    if (std::shared_ptr<BackendWorker> worker = BackendWorkers::get().Find(pluginName)) 
     {
-        LOG_ERROR(fmt::format("couldn't get thread state ptr from plugin [{}], maybe it crashed or exited early?", pluginName));
-        ErrorToLogger(pluginName, fmt::format("Failed to evaluate script: {}", functionCall.dump()));
-
-        return { "overstepped partying thread state", Error };
+        response = worker->Invoke(functionCall);
     }
-
-    auto& [strPluginName, threadState, interpMutex] = *result.value();
-
-    if (threadState == nullptr) 
+    else 
     {
-        LOG_ERROR(fmt::format("couldn't get thread state ptr from plugin [{}], maybe it crashed or exited early?", pluginName));
-        ErrorToLogger(pluginName, fmt::format("Failed to evaluate script: {}", functionCall.dump()));
+        std::shared_ptr<PluginExecutor> executor = PythonManager::GetInstance().GetPluginExecutor(pluginName);
 
-        return { "overstepped partying thread state", Error };
-    }
-
-    std::shared_ptr<PythonGIL> pythonGilLock = std::make_shared<PythonGIL>();
-    pythonGilLock->HoldAndLockGILOnThread(threadState);
+        response = executor ? executor->Invoke<EvalResult>([&]() -> EvalResult 
+        {
+            if (!PyImport_AddModule("__main__")) 
+            {
+                const auto message = fmt::format("Failed to fetch python module on [{}]. This usually means the GIL could not be acquired either because the backend froze or crashed", pluginName);
 
-    if (threadState == NULL) 
-    {
-        LOG_ERROR("script execution was queried but the receiving parties thread state was nullptr");
-        ErrorToLogger(pluginName, fmt::format("Failed to evaluate script: {}", functionCall.dump()));
+                ErrorToLogger(pluginName, message);
+                return { message, Python::Types::Error };
+            }
 
-        return { "thread state was nullptr", Error };
+            return PyObjectCastEvalResult(callPythonFunctionWithJson(functionCall));
+        }) : std::nullopt;
     }
 
-    PyObject* mainModule = PyImport_AddModule("__main__");
-
-    if (!mainModule) 
+    if (!response.has_value()) 
     {
-        const auto message = fmt::format("Failed to fetch python module on [{}]. This usually means the GIL could not be acquired either because the backend froze or crashed", pluginName);
+        LOG_ERROR(fmt::format("couldn't get thread state ptr from plugin [{}], maybe it crashed or exited early?", pluginName));
+        ErrorToLogger(pluginName, fmt::format("Failed to evaluate script: {}", functionCall.dump()));
 
-        ErrorToLogger(pluginName, message);
-        return { message, Python::Types::Error };
+        return { "overstepped partying thread state", Error };
     }
-
-    PyObject* globalDictionaryObj = PyModule_GetDict(mainModule);
-    Python::EvalResult response = PyObjectCastEvalResult(callPythonFunctionWithJson(functionCall));
-
-    pythonGilLock->ReleaseAndUnLockGIL();
-    return response;
+    return std::move(response.value());
 }
 
 /**
- * Locks the Python Global Interpreter Lock (GIL) for the specified plugin's thread state
- * and evaluates the given Python script, discarding the result.
+ * Notifies the specified plugin's backend that its frontend has loaded by calling `plugin._front_end_loaded()`
+ * on the plugin's executor, discarding the result.
  *
- * @param {std::string} pluginName - The name of the plugin requesting script evaluation.
- * @param {std::string} script - The Python script to execute.
- * 
- * This function retrieves the Python thread state associated with the given plugin and locks the GIL.
- * If the thread state cannot be obtained, an error is logged, and execution is aborted.
- * 
- * The script is then executed within the `__main__` module context, but the result is discarded.
- * If an error occurs during execution, it is logged, and the function exits without returning a value.
+ * @param {std::string} pluginName - The name of the plugin whose frontend loaded.
  * 
  * Possible error conditions:
- * - If the thread state cannot be retrieved, an error is logged.
- * - If the evaluated script causes an exception, the error message and traceback are logged.
- * - If the script references an undefined function (e.g., `plugin` is not defined), a specific error is logged.
+ * - If the plugin has no running executor, an error is logged.
+ * - If `plugin` isn't defined or `_front_end_loaded` raises, the error message and traceback are logged.
  * 
- * The function ensures that the GIL is properly acquired and released before and after execution.
+ * Blocks until the notification has been delivered, so it is ordered before any call that follows it.
  */
 MILLENNIUM void Python::CallFrontEndLoaded(std::string pluginName)
 {
@@ -452,27 +830,15 @@ MILLENNIUM void Python::CallFrontEndLoaded(std::string pluginName)
         return;
     }
 
-    auto result = PythonManager::GetInstance().GetPythonThreadStateFromName(pluginName);
-
-    if (!result.has_value()) 
+    if (std::shared_ptr<BackendWorker> worker = BackendWorkers::get().Find(pluginName)) 
     {
-        LOG_ERROR(fmt::format("couldn't get thread state ptr from plugin [{}], maybe it crashed or exited early? Tried to delegate frontend loaded message.", pluginName));
-        ErrorToLogger(pluginName, fmt::format("Failed to delegate frontend loaded message for {}.", pluginName));
-
+        worker->NotifyFrontendLoaded();
         return;
     }
 
-    auto& [strPluginName, threadState, interpMutex] = *result.value();
+    std::shared_ptr<PluginExecutor> executor = PythonManager::GetInstance().GetPluginExecutor(pluginName);
 
-    if (threadState == nullptr) 
-    {
-        LOG_ERROR(fmt::format("couldn't get thread state ptr from plugin [{}], maybe it crashed or exited early? Tried to delegate frontend loaded message.", pluginName));
-        ErrorToLogger(pluginName, fmt::format("Failed to delegate frontend loaded message for {}.", pluginName));
-        return;
-    }
-
-    std::shared_ptr<PythonGIL> pythonGilLock = std::make_shared<PythonGIL>();
-    pythonGilLock->HoldAndLockGILOnThread(threadState);
+    const std::optional<bool> delivered = executor ? executor->Invoke<bool>([&pluginName]() 
     {
         PyObject* globalDictionaryObj = PyModule_GetDict(PyImport_AddModule("__main__"));
         PyObject* plugin = PyDict_GetItemString(globalDictionaryObj, "plugin");
@@ -485,7 +851,7 @@ MILLENNIUM void Python::CallFrontEndLoaded(std::string pluginName)
                 LOG_ERROR(fmt::format("Failed to get plugin attribute: {}:\n{}", errorMsg, traceback));
                 ErrorToLogger(pluginName, fmt::format("Failed to get plugin attribute: {}:\n{}", errorMsg, traceback));
             }
-            return;
+            return true;
         }
 
         PyObject* result = PyObject_CallMethod(plugin, "_front_end_loaded", nullptr);
@@ -493,13 +859,16 @@ MILLENNIUM void Python::CallFrontEndLoaded(std::string pluginName)
             auto [errorMsg, traceback] = Python::ActiveExceptionInformation();
             LOG_ERROR(fmt::format("Failed to call _front_end_loaded: {}:\n{}", errorMsg, traceback));
             ErrorToLogger(pluginName, fmt::format("Failed to call _front_end_loaded: {}:\n{}", errorMsg, traceback));
-            Py_DECREF(plugin);
-            return;
+            return true;
         }
 
         Py_DECREF(result);
-        // Py_DECREF(plugin); Oops this is a borrowed ref. 
-        return;
+        return true;
+    }) : std::nullopt;
+
+    if (!delivered.has_value()) 
+    {
+        LOG_ERROR(fmt::format("couldn't get thread state ptr from plugin [{}], maybe it crashed or exited early? Tried to delegate frontend loaded message.", pluginName));
+        ErrorToLogger(pluginName, fmt::format("Failed to delegate frontend loaded message for {}.", pluginName));
     }
-    pythonGilLock->ReleaseAndUnLockGIL();
 }
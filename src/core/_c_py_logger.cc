@@ -34,6 +34,7 @@
 #include <fstream>
 #include "fvisible.h"
 
+std::mutex g_loggerListMutex;
 std::vector<BackendLogger*> g_loggerList;
 
 /**
@@ -74,6 +75,8 @@ MILLENNIUM PyObject* LoggerObject_new(PyTypeObject *type, PyObject *args, PyObje
     PyObject* value = PyDict_GetItemString(builtins, "MILLENNIUM_PLUGIN_SECRET_NAME");
     std::string pluginName = value ? PyUnicode_AsUTF8(value) : "ERRNO_PLUGIN_NAME";
 
+    std::lock_guard<std::mutex> lock(g_loggerListMutex);
+
     /** Check if the logger already exists, and use it if it does */
     for (auto logger : g_loggerList) 
     {
@@ -105,7 +108,11 @@ MILLENNIUM PyObject* LoggerObject_new(PyTypeObject *type, PyObject *args, PyObje
 MILLENNIUM void LoggerObject_dealloc(LoggerObject *self)
 {
     /** Don't delete the logger here since it's shared in g_loggerList */
-    Py_TYPE(self)->tp_free((PyObject *)self);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free((PyObject *)self);
+
+    /** Instances of heap types own a reference to their type. */
+    Py_DECREF(type);
 }
 
 /**
@@ -194,23 +201,59 @@ static PyMethodDef LoggerObject_methods[] =
 };
 
 /**
- * @brief The type object for the LoggerObject instance.
+ * @brief The type spec for the LoggerObject instance.
+ * 
+ * The type is created as a heap type for each interpreter that imports the module, a static type would be 
+ * shared between interpreters, which isn't allowed once they stop sharing a GIL.
+ */
+static PyType_Slot g_loggerTypeSlots[] = 
+{
+    { Py_tp_dealloc, (void*)LoggerObject_dealloc  },
+    { Py_tp_doc,     (void*)"Logger object"       },
+    { Py_tp_methods, (void*)LoggerObject_methods  },
+    { Py_tp_new,     (void*)LoggerObject_new      },
+    { 0, NULL }
+};
+
+static PyType_Spec g_loggerTypeSpec 
+{
+    .name = "logger.Logger",
+    .basicsize = sizeof(LoggerObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots = g_loggerTypeSlots,
+};
+
+/**
+ * @brief Executes the logger module for the importing interpreter, adding its own Logger type.
  * 
- * This object defines the type for the LoggerObject instance.
+ * @param {PyObject*} loggerModule - The module being executed.
  * 
- * @returns {PyTypeObject*} - A pointer to the type object for the LoggerObject instance.
+ * @returns {int} - 0 on success, -1 with a Python exception set otherwise.
  */
-PyTypeObject LoggerType 
+static int ExecLoggerModule(PyObject* loggerModule)
+{
+    PyObject* loggerType = PyType_FromSpec(&g_loggerTypeSpec);
+    if (loggerType == NULL) 
+    {
+        return -1;
+    }
+
+    if (PyModule_AddObject(loggerModule, "Logger", loggerType) < 0) 
+    {
+        Py_DECREF(loggerType);
+        return -1;
+    }
+    return 0;
+}
+
+static PyModuleDef_Slot g_loggerModuleSlots[] = 
 {
-    PyVarObject_HEAD_INIT(NULL, 0)
-    .tp_name = "logger.Logger",
-    .tp_basicsize = sizeof(LoggerObject),
-    .tp_itemsize = 0,
-    .tp_dealloc = (destructor)LoggerObject_dealloc,
-    .tp_flags = Py_TPFLAGS_DEFAULT,
-    .tp_doc = "Logger object",
-    .tp_methods = LoggerObject_methods,
-    .tp_new = LoggerObject_new,
+    { Py_mod_exec, (void*)ExecLoggerModule },
+#if PY_VERSION_HEX >= 0x030C0000
+    { Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED },
+#endif
+    { 0, NULL }
 };
 
 /**
@@ -225,41 +268,21 @@ static struct PyModuleDef g_loggerModuleDef
     .m_base = PyModuleDef_HEAD_INIT,
     .m_name = "logger",
     .m_doc = "Millennium logger module",
-    .m_size = -1,
+    .m_size = 0,
     .m_methods = LoggerObject_methods,
+    .m_slots = g_loggerModuleSlots,
 };
 
 /**
  * @brief Initializes the logger module.
  * 
- * This function initializes the logger module.
+ * The module uses multi-phase initialization, the Logger type is created in ExecLoggerModule.
  * 
- * @returns {PyObject*} - A pointer to the logger module.
+ * @returns {PyObject*} - The module definition, see PyModuleDef_Init.
  */
 MILLENNIUM PyObject* PyInit_Logger(void)
 {
-    if (PyType_Ready(&LoggerType) < 0)
-    {
-        /** Failing indicates a serious initialization error */
-        return NULL;
-    }
-
-    /** Create the logger module */
-    PyObject *loggerModule = PyModule_Create(&g_loggerModuleDef);
-    if (loggerModule == NULL)
-    {
-        return NULL;
-    }
-
-    Py_INCREF(&LoggerType);
-    if (PyModule_AddObject(loggerModule, "Logger", (PyObject *)&LoggerType) < 0) 
-    {
-        Py_DECREF(&LoggerType);
-        Py_DECREF(loggerModule);
-        return NULL;
-    }
-
-    return loggerModule;
+    return PyModuleDef_Init(&g_loggerModuleDef);
 }
 
 /** 
@@ -270,6 +293,8 @@ MILLENNIUM PyObject* PyInit_Logger(void)
  */
 MILLENNIUM void CleanupLoggers()
 {
+    std::lock_guard<std::mutex> lock(g_loggerListMutex);
+
     for (auto logger : g_loggerList) {
         delete logger;
     }
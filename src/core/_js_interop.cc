@@ -31,10 +31,17 @@
 #include "ffi.h"
 #include "co_spawn.h"
 #include "loader.h"
+#include "js_escape.h"
+#include "encoding.h"
 #include <future>
 #include "fvisible.h"
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <deque>
+#include <unordered_set>
 #include "fvisible.h"
 
 struct EvalResult 
@@ -43,167 +50,524 @@ struct EvalResult
     bool successfulCall;
 };
 
-#define SHARED_JS_EVALUATE_ID 54999
+/**
+ * Shared context evaluations are numbered from here, well clear of the fixed ids used elsewhere 
+ * on the shared socket (see co_stub.cc, loader.cc, http_hooks.cc) so responses can't be mistaken for each other.
+ */
+static constexpr int64_t SHARED_JS_EVALUATE_ID_BASE = 1'000'000'000;
+static std::atomic<int64_t> sharedJsEvaluateId { SHARED_JS_EVALUATE_ID_BASE };
+
+/**
+ * Thrown by ExecuteOnSharedJsContext when the frontend didn't answer within the allowed time.
+ */
+class EvaluateTimeoutError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Thrown when a call can't be deferred because too many calls are already waiting on frontends, see DeferredFrontendCalls.
+ */
+class FrontendQueueFullError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Set the Python exception for a frontend call that couldn't be started.
+ * A full deferred call queue raises `RuntimeError`, anything else (no connection, shutting down) a `ConnectionError`, both with the reason.
+ */
+static void SetFrontendCallError(const std::exception& ex)
+{
+    PyErr_SetString(dynamic_cast<const FrontendQueueFullError*>(&ex) ? PyExc_RuntimeError : PyExc_ConnectionError, ex.what());
+}
+
+using EvalCallback = std::function<void(EvalResult)>;
+
+/** Stops waiting on a request started by a StartRequest, safe to call after it completed. */
+using CancelRequest = std::function<void()>;
+/** Starts a request on the shared context, `onResult` is invoked on the socket thread at most once. May throw if nothing could be sent. */
+using StartRequest = std::function<CancelRequest(EvalCallback onResult)>;
 
 /**
- * Executes JavaScript code on the SharedJSContext and retrieves the result.
+ * Sends a Runtime domain request to the SharedJSContext without waiting for it.
  *
- * @param {std::string} javaScriptEval - The JavaScript expression to evaluate.
- * @returns {EvalResult} - The result of the evaluation, containing the evaluated value and a success flag.
+ * @param {const std::string&} method - The CDP method, i.e Runtime.evaluate or Runtime.callFunctionOn.
+ * @param {nlohmann::json} params - The method parameters.
+ * @param {EvalCallback} onResult - Invoked on the socket thread with the result, at most once.
+ * @returns {int64_t} - The id of the request, can be passed to CancelSharedJsEvaluation.
  *
- * This function sends a message via a socket to request JavaScript evaluation. It listens for a response,
- * processes the result, and stores it in `evalResult`. The function waits for the result using a 
- * condition variable before returning.
+ * Every call gets its own message id, and its response is routed straight to it by id, so any number of requests 
+ * may be in flight at once without every socket message visiting all of them.
+ * The response handler is registered before the request is sent and is forgotten once it has seen its response.
  *
  * Error handling:
- * - If the message cannot be sent, an exception is thrown.
- * - If an exception occurs in the JavaScript execution, the error description is returned in `evalResult`.
- * - If the frontend is not loaded, an exception is thrown.
- *
- * Synchronization:
- * - Uses a `std::mutex` and `std::condition_variable` to ensure safe access to shared data.
- * - The listener is removed once a response is received.
+ * - If the message cannot be sent, an exception is thrown and `onResult` is never invoked.
+ * - If an exception occurs in the JavaScript execution, the error description is passed on with `successfulCall` unset.
+ * - If the frontend is not loaded, the result holds "__CONNECTION_ERROR__".
  */
-MILLENNIUM const EvalResult ExecuteOnSharedJsContext(std::string javaScriptEval) 
+MILLENNIUM int64_t SendSharedJsRequest(const std::string& method, nlohmann::json params, EvalCallback onResult) 
 {
-    std::mutex mtx;
-    std::condition_variable cv;
-    EvalResult evalResult;
-    bool resultReady = false;  // Flag to indicate when the result is ready
-
-    bool messageSendSuccess = Sockets::PostShared(nlohmann::json({ 
-        { "id", SHARED_JS_EVALUATE_ID },
-        { "method", "Runtime.evaluate" }, 
-        { "params", {
-            { "expression", javaScriptEval }, 
-            { "awaitPromise", true }
-        }} 
-    }));
-
-    if (!messageSendSuccess) 
-    {
-        throw std::runtime_error("couldn't send message to socket");
-    }
+    const int64_t requestId = sharedJsEvaluateId.fetch_add(1, std::memory_order_relaxed);
 
-    std::string listenerId = JavaScript::SharedJSMessageEmitter::InstanceRef().OnMessage("msg", "ExecuteOnSharedJsContext", [&](const nlohmann::json& eventMessage, std::string listenerId) 
+    auto& emitter = JavaScript::SharedJSMessageEmitter::InstanceRef();
+    emitter.OnResponse(requestId, [onResult](const nlohmann::json& response) 
     {
-        std::lock_guard<std::mutex> lock(mtx);  // Lock mutex for safe access
-
-        nlohmann::json response = eventMessage;
-        std::string method = response.value("method", std::string());
-
-        if (method.find("Debugger") != std::string::npos || method.find("Console") != std::string::npos) 
-        {
-            return;
-        }
+        EvalResult evalResult;
 
         try 
         {
-            if (!response.contains("id") || (response.contains("id") && !response["id"].is_null() && response["id"] != SHARED_JS_EVALUATE_ID))
+            /** Protocol level failures, i.e a result that can't be serialized by value. */
+            if (response.contains("error"))
             {
-                return;
+                evalResult = { response["error"].value("message", std::string("unknown protocol error")), false };
             }
-
-            if (response["result"].contains("exceptionDetails"))
+            else if (response["result"].contains("exceptionDetails"))
             {
-                const std::string classType = response["result"]["exceptionDetails"]["exception"]["className"];
+                const auto& exceptionDetails = response["result"]["exceptionDetails"];
+                const auto exception = exceptionDetails.value("exception", nlohmann::json::object());
 
                 // Custom exception type thrown from CallFrontendMethod in executor.cc
-                if (classType == "MillenniumFrontEndError") 
+                if (exception.value("className", std::string()) == "MillenniumFrontEndError") 
                     evalResult = { "__CONNECTION_ERROR__", false };
                 else
-                    evalResult = { response["result"]["exceptionDetails"]["exception"]["description"], false };
+                    evalResult = { exception.value("description", exceptionDetails.value("text", std::string("Uncaught"))), false };
             }
             else 
             {
                 evalResult = { response["result"]["result"], true };
             }
-
-            resultReady = true;
-            cv.notify_one();  // Signal that result is ready
-            JavaScript::SharedJSMessageEmitter::InstanceRef().RemoveListener("msg", listenerId);
         }
         catch (nlohmann::detail::exception& ex) 
         {
             LOG_ERROR(fmt::format("JavaScript::SharedJSMessageEmitter error -> {}", ex.what()));
+            return;
         }
+
+        onResult(std::move(evalResult));
     });
 
-    // Wait for the result to be ready
-    std::unique_lock<std::mutex> lock(mtx);
-    cv.wait(lock, [&] { return resultReady; });
+    bool messageSendSuccess = Sockets::PostShared(nlohmann::json({ 
+        { "id", requestId },
+        { "method", method }, 
+        { "params", std::move(params) } 
+    }));
 
-    if (!evalResult.successfulCall && evalResult.json == "__CONNECTION_ERROR__") 
+    if (!messageSendSuccess) 
     {
+        emitter.RemoveResponseHandler(requestId);
         throw std::runtime_error("frontend is not loaded!");
     }
 
-    return evalResult;
+    return requestId;
+}
+
+/**
+ * @brief Stop listening for the response to a request made with SendSharedJsRequest.
+ * Safe to call after the response already arrived.
+ */
+MILLENNIUM void CancelSharedJsEvaluation(int64_t requestId)
+{
+    JavaScript::SharedJSMessageEmitter::InstanceRef().RemoveResponseHandler(requestId);
+}
+
+/**
+ * @brief Get a StartRequest evaluating `javaScriptEval` with Runtime.evaluate.
+ * Results are requested by value, so objects and arrays arrive as JSON rather than as remote object handles.
+ */
+static StartRequest SharedJsEvaluation(std::string javaScriptEval)
+{
+    return [javaScriptEval = std::move(javaScriptEval)](EvalCallback onResult) -> CancelRequest
+    {
+        const int64_t requestId = SendSharedJsRequest("Runtime.evaluate", {
+            { "expression", javaScriptEval }, 
+            { "awaitPromise", true },
+            { "returnByValue", true }
+        }, 
+        std::move(onResult));
+
+        return [requestId] { CancelSharedJsEvaluation(requestId); };
+    };
 }
 
 /**
- * Escapes special characters in a JavaScript string.
+ * Frontend calls made before the calling plugin's frontend reported itself loaded, i.e from a backend's `_load`.
+ * 
+ * Rather than failing (or waiting on a context that doesn't exist yet) they are parked here and started in 
+ * order once the plugin's frontend sends FrontEndLoaded over IPC. The queue is bounded, and every entry carries the 
+ * deadline of its caller, entries whose caller already gave up are dropped instead of being started late.
+ * Readiness is forgotten whenever the SharedJSContext is reattached or navigated, as every frontend reloads then.
+ * 
+ * Frontends are only injected once every backend called Millennium.ready(). A blocking call from a backend that 
+ * hasn't yet would hold up its own ready() (and with it every frontend) until it times out, so those are never 
+ * deferred and fail straight away like they did before the frontend was loaded. Awaitable calls are always deferred.
  */
-std::string EscapeJavaScriptString(const std::string& input)
+class DeferredFrontendCalls
 {
-    std::ostringstream escaped;
-    escaped << std::hex;
+private:
+    struct DeferredCall 
+    {
+        std::string pluginName;
+        StartRequest startRequest;
+        EvalCallback onResult;
+        std::chrono::steady_clock::time_point deadline;
+
+        /** Guards the fields below, never held while `onResult` runs. */
+        std::mutex mutex;
+        CancelRequest cancelRequest;
+        bool cancelled = false;
+        bool started = false;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_set<std::string> m_readyPlugins;
+    std::unordered_set<std::string> m_readyBackends;
+    std::deque<std::shared_ptr<DeferredCall>> m_queue;
+    bool m_shutdown = false;
 
-    for (unsigned char c : input) 
+    /** Drops entries that were cancelled or whose deadline passed, m_mutex must be held. */
+    void PruneLocked()
     {
-        switch (c) 
+        const auto now = std::chrono::steady_clock::now();
+
+        m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(), [now](const std::shared_ptr<DeferredCall>& call) 
+        {
+            std::lock_guard<std::mutex> lock(call->mutex);
+            return call->cancelled || call->deadline <= now;
+        }), 
+        m_queue.end());
+    }
+
+    /** Starts a call that was waiting on its frontend, unless its caller gave up in the meantime. */
+    static void Start(const std::shared_ptr<DeferredCall>& call)
+    {
+        bool sendFailed = false;
+        {
+            std::lock_guard<std::mutex> lock(call->mutex);
+
+            if (call->cancelled || call->started || call->deadline <= std::chrono::steady_clock::now()) 
+            {
+                return;
+            }
+            call->started = true;
+
+            try 
+            {
+                call->cancelRequest = call->startRequest(call->onResult);
+            }
+            catch (const std::exception&) 
+            {
+                sendFailed = true;
+            }
+        }
+
+        if (sendFailed) 
+        {
+            call->onResult({ "__CONNECTION_ERROR__", false });
+        }
+    }
+
+public:
+    /** Calls waiting on frontends at once, further calls fail straight away. */
+    static constexpr size_t MAX_DEFERRED_CALLS = 256;
+
+    static DeferredFrontendCalls& get()
+    {
+        static DeferredFrontendCalls instance;
+        return instance;
+    }
+
+    /**
+     * @brief Wrap a request so it only starts once `pluginName`'s frontend is loaded.
+     * @param {std::chrono::milliseconds} timeout - The caller's timeout, the request isn't started after it passed.
+     * @param {bool} isBlocking - The caller blocks its thread on the result, only deferred once the plugin's backend called ready().
+     */
+    StartRequest Gate(std::string pluginName, StartRequest startRequest, std::chrono::milliseconds timeout, bool isBlocking)
+    {
+        return [this, pluginName = std::move(pluginName), startRequest = std::move(startRequest), timeout, isBlocking](EvalCallback onResult) -> CancelRequest
         {
-            case '\"': escaped << "\\\""; break;
-            case '\\': escaped << "\\\\"; break;
-            case '\b': escaped << "\\b";  break;
-            case '\f': escaped << "\\f";  break;
-            case '\n': escaped << "\\n";  break;
-            case '\r': escaped << "\\r";  break;
-            case '\t': escaped << "\\t";  break;
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (m_shutdown) 
+            {
+                throw std::runtime_error("Millennium is shutting down");
+            }
+
+            if (m_readyPlugins.count(pluginName) || (isBlocking && !m_readyBackends.count(pluginName))) 
+            {
+                lock.unlock();
+                return startRequest(std::move(onResult));
+            }
 
-            default:
-                if (c < 0x20 || c == 0x2028 || c == 0x2029) 
+            this->PruneLocked();
+
+            if (m_queue.size() >= MAX_DEFERRED_CALLS) 
+            {
+                Logger.Warn("Too many frontend calls are waiting on frontends to load, failing call from [{}].", pluginName);
+                throw FrontendQueueFullError("too many frontend calls are waiting on frontends to load");
+            }
+
+            auto call = std::make_shared<DeferredCall>();
+            call->pluginName   = pluginName;
+            call->startRequest = startRequest;
+            call->onResult     = std::move(onResult);
+            call->deadline     = std::chrono::steady_clock::now() + timeout;
+
+            m_queue.push_back(call);
+
+            return [call] 
+            {
+                CancelRequest cancelRequest;
                 {
-                    // Escape control and unsafe unicode chars as \uXXXX
-                    escaped << "\\u"
-                            << std::uppercase
-                            << std::setw(4)
-                            << std::setfill('0')
-                            << static_cast<int>(c);
-                } 
-                else 
+                    std::lock_guard<std::mutex> lock(call->mutex);
+                    call->cancelled = true;
+                    cancelRequest = call->cancelRequest;
+                }
+
+                if (cancelRequest) 
                 {
-                    escaped << c;
+                    cancelRequest();
                 }
-                break;
+            };
+        };
+    }
+
+    /**
+     * @brief Mark a plugin's frontend as loaded and start the calls waiting on it, in the order they were made.
+     */
+    void MarkReady(const std::string& pluginName)
+    {
+        std::vector<std::shared_ptr<DeferredCall>> readyCalls;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_readyPlugins.insert(pluginName);
+
+            for (auto it = m_queue.begin(); it != m_queue.end(); ) 
+            {
+                if ((*it)->pluginName == pluginName) 
+                {
+                    readyCalls.push_back(std::move(*it));
+                    it = m_queue.erase(it);
+                }
+                else ++it;
+            }
+        }
+
+        for (const auto& call : readyCalls) 
+        {
+            Start(call);
+        }
+    }
+
+    /**
+     * @brief Track whether a plugin's backend called Millennium.ready(), see Gate.
+     */
+    void SetBackendReady(const std::string& pluginName, bool isReady)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (isReady) 
+            m_readyBackends.insert(pluginName);
+        else 
+            m_readyBackends.erase(pluginName);
+    }
+
+    /**
+     * @brief Forget which frontends are loaded, new calls are deferred until they report in again.
+     */
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_readyPlugins.clear();
+    }
+
+    /**
+     * @brief Fail every waiting call with a ConnectionError and refuse new ones.
+     */
+    void Shutdown()
+    {
+        std::deque<std::shared_ptr<DeferredCall>> pendingCalls;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+            m_readyPlugins.clear();
+            pendingCalls.swap(m_queue);
+        }
+
+        for (const auto& call : pendingCalls) 
+        {
+            {
+                std::lock_guard<std::mutex> lock(call->mutex);
+
+                if (call->cancelled || call->started) 
+                {
+                    continue;
+                }
+                call->cancelled = true;
+            }
+            call->onResult({ "__CONNECTION_ERROR__", false });
+        }
+    }
+};
+
+/**
+ * @brief Called when a plugin's frontend reported itself loaded over IPC, starts the frontend calls waiting on it.
+ */
+MILLENNIUM void JavaScript::MarkFrontendReady(const std::string& pluginName)
+{
+    DeferredFrontendCalls::get().MarkReady(pluginName);
+}
+
+/**
+ * @brief Called when a plugin's backend called Millennium.ready(), from then on its blocking frontend calls may be deferred.
+ */
+MILLENNIUM void JavaScript::MarkBackendReady(const std::string& pluginName)
+{
+    DeferredFrontendCalls::get().SetBackendReady(pluginName, true);
+}
+
+/**
+ * @brief Called when a plugin's backend is unloaded, it has to call Millennium.ready() again once it is restarted.
+ */
+MILLENNIUM void JavaScript::ForgetBackendReady(const std::string& pluginName)
+{
+    DeferredFrontendCalls::get().SetBackendReady(pluginName, false);
+}
+
+/**
+ * @brief Forgets which frontends are loaded, and makes sure that happens again whenever the shared context navigates.
+ * Called whenever Millennium attaches to a (new) SharedJSContext session.
+ */
+MILLENNIUM void JavaScript::ResetFrontendReadiness()
+{
+    static std::once_flag listenerRegistered;
+
+    std::call_once(listenerRegistered, []
+    {
+        JavaScript::SharedJSMessageEmitter::InstanceRef().OnMessage("msg", "DeferredFrontendCalls", [](const nlohmann::json& eventMessage, std::string listenerId)
+        {
+            /** Other targets plugins enabled Runtime on (see CdpPassthrough) navigate too, only the SharedJSContext reloads frontends. */
+            if (eventMessage.value("method", std::string()) == "Runtime.executionContextsCleared" && Sockets::IsSharedJsContextMessage(eventMessage)) 
+            {
+                DeferredFrontendCalls::get().Reset();
+            }
+        });
+    });
+
+    DeferredFrontendCalls::get().Reset();
+}
+
+/**
+ * @brief Fails every frontend call still waiting on its frontend, called on shutdown.
+ */
+MILLENNIUM void JavaScript::CancelDeferredFrontendCalls()
+{
+    DeferredFrontendCalls::get().Shutdown();
+}
+
+/**
+ * Runs a request on the SharedJSContext and waits for its result.
+ *
+ * @param {StartRequest} startRequest - The request to run, see SharedJsEvaluation and FrontendMethodInvocation.
+ * @param {std::chrono::milliseconds} timeout - How long to wait for the frontend to respond.
+ * @returns {EvalResult} - The result of the evaluation, containing the evaluated value and a success flag.
+ *
+ * Safe to call from any number of threads at once. The call state is shared with the listener through a 
+ * std::shared_ptr, so a response arriving after the caller gave up never touches a dead stack frame.
+ * Must be called without the GIL held, a plugin executor thread keeps running its queued work while it waits.
+ *
+ * Error handling:
+ * - If the message cannot be sent, an exception is thrown.
+ * - If the frontend is not loaded, an exception is thrown.
+ * - If no response arrives within `timeout`, an EvaluateTimeoutError is thrown.
+ */
+MILLENNIUM const EvalResult ExecuteOnSharedJsContext(const StartRequest& startRequest, std::chrono::milliseconds timeout) 
+{
+    struct PendingEvaluation 
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        EvalResult evalResult;
+        bool resultReady = false;
+    };
+
+    auto pending = std::make_shared<PendingEvaluation>();
+
+    /** On a plugin executor, keep running the plugin's queued work while waiting, the frontend may be calling back into it. */
+    std::shared_ptr<PluginExecutor> executor = PluginExecutor::Current();
+
+    const CancelRequest cancelRequest = startRequest([pending, executor](EvalResult evalResult) 
+    {
+        {
+            std::lock_guard<std::mutex> lock(pending->mtx);
+            pending->evalResult  = std::move(evalResult);
+            pending->resultReady = true;
+        }
+        pending->cv.notify_one();  // Signal that result is ready
+
+        if (executor) 
+        {
+            executor->Wake();
         }
+    });
+
+    bool resultReady;
+
+    if (executor) 
+    {
+        resultReady = executor->RunPendingUntil([&] 
+        {
+            std::lock_guard<std::mutex> lock(pending->mtx);
+            return pending->resultReady;
+        }, 
+        std::chrono::steady_clock::now() + timeout);
+    }
+
+    std::unique_lock<std::mutex> lock(pending->mtx);
+
+    if (!executor) 
+    {
+        resultReady = pending->cv.wait_for(lock, timeout, [&] { return pending->resultReady; });
+    }
+
+    if (!resultReady)
+    {
+        cancelRequest();
+        throw EvaluateTimeoutError(fmt::format("frontend didn't respond within {}ms", timeout.count()));
+    }
+
+    if (!pending->evalResult.successfulCall && pending->evalResult.json == "__CONNECTION_ERROR__") 
+    {
+        throw std::runtime_error("frontend is not loaded!");
     }
 
-    return escaped.str();
+    return std::move(pending->evalResult);
 }
 
 /**
- * Constructs a JavaScript function call string for a given plugin and method.
+ * Appends a JavaScript function call for a given plugin and method to `strFunctionFormatted`.
  *
+ * @param {std::string&} strFunctionFormatted - Sink the call expression is appended to.
  * @param {const char*} plugin - The name of the plugin containing the JavaScript function.
  * @param {const char*} methodName - The name of the method to be called on the plugin.
  * @param {std::vector<JavaScript::JsFunctionConstructTypes>} fnParams - A list of function parameters, 
  *        each containing a type and value.
- * @returns {std::string} - A formatted JavaScript function call string.
  *
  * This function builds a JavaScript function call in the format:
  * `PLUGIN_LIST['pluginName'].methodName(param1, param2, ...)`
  *
  * Parameter handling:
- * - Strings are enclosed in double quotes.
+ * - Strings are escaped (see JavaScript::EscapeStringInto) and enclosed in double quotes.
  * - Boolean values are converted from `"True"`/`"False"` to JavaScript `true`/`false`.
  * - Other types are inserted as-is.
  *
  * If multiple parameters exist, they are separated by commas.
  */
-MILLENNIUM const std::string JavaScript::ConstructFunctionCall(const char* plugin, const char* methodName, std::vector<JavaScript::JsFunctionConstructTypes> fnParams)
+static void AppendFunctionCall(std::string& strFunctionFormatted, const char* plugin, const char* methodName, const std::vector<JavaScript::JsFunctionConstructTypes>& fnParams)
 {
-    std::string strFunctionFormatted = fmt::format("PLUGIN_LIST['{}'].{}(", plugin, methodName);
+    fmt::format_to(std::back_inserter(strFunctionFormatted), "PLUGIN_LIST['{}'].{}(", plugin, methodName);
 
     std::map<std::string, std::string> boolMap
     {
@@ -219,7 +583,9 @@ MILLENNIUM const std::string JavaScript::ConstructFunctionCall(const char* plugi
         {
             case JavaScript::Types::String: 
             {
-                strFunctionFormatted += fmt::format("\"{}\"", EscapeJavaScriptString(param.pluginName));
+                strFunctionFormatted.push_back('"');
+                JavaScript::EscapeStringInto(param.pluginName, strFunctionFormatted);
+                strFunctionFormatted.push_back('"');
                 break;
             }
             case JavaScript::Types::Boolean: 
@@ -239,58 +605,1036 @@ MILLENNIUM const std::string JavaScript::ConstructFunctionCall(const char* plugi
             strFunctionFormatted += ", ";
         }
     }
-    strFunctionFormatted += ");"; return strFunctionFormatted;
+    strFunctionFormatted += ")";
 }
 
 /**
- * Evaluates a JavaScript script via a shared socket connection and converts the result to a PyObject.
+ * Marker key binary values are wrapped in when a call opts into binary results, 
+ * i.e an ArrayBuffer becomes { "$millenniumBytes": "<base64>" } and is turned into `bytes` on the way back.
+ */
+static constexpr const char* BINARY_RESULT_KEY = "$millenniumBytes";
+
+/**
+ * JavaScript function wrapping every ArrayBuffer and ArrayBuffer view in a value (recursively through plain 
+ * objects and arrays) with BINARY_RESULT_KEY. Those would otherwise be serialized as empty objects by returnByValue.
+ */
+static const std::string encodeBinaryFunction = fmt::format(
+    "(function encode(value) {{ "
+        "if (value instanceof ArrayBuffer || ArrayBuffer.isView(value)) {{ "
+            "const bytes = value instanceof ArrayBuffer ? new Uint8Array(value) : new Uint8Array(value.buffer, value.byteOffset, value.byteLength); "
+            "let binary = ''; for (let i = 0; i < bytes.length; i += 0x8000) binary += String.fromCharCode.apply(null, bytes.subarray(i, i + 0x8000)); "
+            "return {{ '{}': btoa(binary) }}; "
+        "}} "
+        "if (Array.isArray(value)) return value.map(encode); "
+        "if (value && typeof value === 'object' && Object.getPrototypeOf(value) === Object.prototype) return Object.fromEntries(Object.entries(value).map(([key, entry]) => [key, encode(entry)])); "
+        "return value; "
+    "}})", 
+    BINARY_RESULT_KEY
+);
+
+/**
+ * Constructs a JavaScript function call statement for a given plugin and method, see AppendFunctionCall.
  *
- * @param {std::string} script - The JavaScript code to be executed.
- * @returns {PyObject*} - A Python object representing the evaluation result.
+ * @param {bool} binaryResults - Wrap binary values in the result so they can be returned as `bytes`, see encodeBinaryFunction.
+ * @returns {std::string} - A formatted JavaScript function call string.
+ */
+MILLENNIUM const std::string JavaScript::ConstructFunctionCall(const char* plugin, const char* methodName, std::vector<JavaScript::JsFunctionConstructTypes> fnParams, bool binaryResults)
+{
+    std::string strFunctionFormatted;
+
+    if (!binaryResults) 
+    {
+        AppendFunctionCall(strFunctionFormatted, plugin, methodName, fnParams);
+        strFunctionFormatted += ";"; return strFunctionFormatted;
+    }
+
+    strFunctionFormatted += "Promise.resolve(";
+    AppendFunctionCall(strFunctionFormatted, plugin, methodName, fnParams);
+    strFunctionFormatted += ").then(" + encodeBinaryFunction + ");"; return strFunctionFormatted;
+}
+
+/**
+ * Constructs a single JavaScript expression that runs several plugin methods in order.
  *
- * This function sends the script for evaluation using `ExecuteOnSharedJsContext()`, processes the response, 
- * and converts the returned JavaScript value into an appropriate Python type:
- * - JavaScript strings → `PyUnicode_FromString`
- * - JavaScript booleans → `PyBool_FromLong`
- * - JavaScript numbers → `PyLong_FromLong`
- * - Unsupported types result in a formatted string indicating an error.
+ * @param {const char*} plugin - The name of the plugin containing the JavaScript functions.
+ * @param {const std::vector<JavaScript::FunctionCall>&} calls - The methods to call and their parameters, in call order.
+ * @param {bool} binaryResults - Wrap binary values in the results so they can be returned as `bytes`, see encodeBinaryFunction.
+ * @returns {std::string} - An expression evaluating to a JSON string, see below.
  *
- * Error Handling:
- * - If the execution fails, a Python `RuntimeError` is raised with the provided error message.
- * - If the frontend is not loaded, a Python `ConnectionError` is set.
- * - If the response cannot be parsed, an error message is returned as a Python string.
+ * Each call is made the same way ConstructFunctionCall would, and awaited before the next one starts. 
+ * A call that throws doesn't stop the rest. The expression resolves to a JSON encoded array with one entry per call, 
+ * either `{ "ok": true, ...<result as a CDP RemoteObject> }` or `{ "ok": false, "error": <description> }`.
+ * BigInts nested inside objects can't be represented in JSON and are passed on as strings.
  */
-MILLENNIUM PyObject* JavaScript::EvaluateFromSocket(std::string script)
+MILLENNIUM const std::string JavaScript::ConstructBatchedFunctionCall(const char* plugin, const std::vector<JavaScript::FunctionCall>& calls, bool binaryResults)
 {
-    try 
+    std::string strBatchFormatted = 
+        "(async (encode, calls) => { "
+            "const remote = (value) => "
+                "typeof value === 'bigint' ? { type: 'bigint', unserializableValue: `${value}n` } : "
+                "typeof value === 'number' && (!Number.isFinite(value) || Object.is(value, -0)) ? { type: 'number', unserializableValue: Object.is(value, -0) ? '-0' : String(value) } : "
+                "{ type: typeof value, value }; "
+            "const results = []; for (const call of calls) { "
+                "try { results.push({ ok: true, ...remote(encode(await call())) }); } "
+                "catch (error) { results.push({ ok: false, error: String(error?.stack ?? error) }); } "
+            "} return JSON.stringify(results, (key, value) => typeof value === 'bigint' ? String(value) : value); "
+        "})(";
+
+    strBatchFormatted += binaryResults ? encodeBinaryFunction : "(value) => value";
+    strBatchFormatted += ", [";
+
+    for (auto iterator = calls.begin(); iterator != calls.end(); ++iterator) 
     {
-        EvalResult response = ExecuteOnSharedJsContext(script);
+        strBatchFormatted += "() => ";
+        AppendFunctionCall(strBatchFormatted, plugin, iterator->methodName.c_str(), iterator->params);
 
-        if (!response.successfulCall) 
+        if (std::next(iterator) != calls.end()) 
         {
-            PyErr_SetString(PyExc_RuntimeError, response.json.get<std::string>().c_str());
-            return NULL;
+            strBatchFormatted += ", ";
         }
+    }
+    strBatchFormatted += "]);"; return strBatchFormatted;
+}
 
-        std::string type = response.json["type"];
+/**
+ * @brief Prefixes a frontend call with a check that the plugin's frontend is actually loaded, aside from SteamUI.
+ * If it isn't, the evaluation throws a MillenniumFrontEndError, which is surfaced to Python as a ConnectionError.
+ */
+MILLENNIUM const std::string JavaScript::GuardFrontendLoaded(const std::string& pluginName, const std::string& script)
+{
+    return fmt::format(
+        "if (typeof window !== 'undefined' && typeof window.MillenniumFrontEndError === 'undefined') {{ window.MillenniumFrontEndError = class MillenniumFrontEndError extends Error {{ constructor(message) {{ super(message); this.name = 'MillenniumFrontEndError'; }} }} }}"
+        "if (typeof PLUGIN_LIST === 'undefined' || !PLUGIN_LIST?.['{}']) throw new window.MillenniumFrontEndError('frontend not loaded yet!');\n\n{}", 
+        JavaScript::EscapeString(pluginName), 
+        script
+    );
+}
 
-        if      (type == "string")  return PyUnicode_FromString(response.json["value"].get<std::string>().c_str());
-        else if (type == "boolean") return PyBool_FromLong     (response.json["value"]);
-        else if (type == "number")  return PyLong_FromLong     (response.json["value"]);
-        else
-            return PyUnicode_FromString(fmt::format("Js function returned unaccepted type '{}'. Accepted types [string, boolean, number]", type).c_str());
+/** Object group the resolved frontend methods are kept alive in, the browser drops it with the execution context. */
+static constexpr const char* FRONTEND_METHOD_OBJECT_GROUP = "millennium-frontend-methods";
 
-    }
-    catch (nlohmann::detail::exception& ex)
+/** Declarations passed to Runtime.callFunctionOn, `this` is the resolved (bound) frontend method. They never change so V8 compiles them once. */
+static const std::string callResolvedMethod       = "function (...args) { return this(...args); }";
+static const std::string callResolvedMethodBinary = "function (...args) { return Promise.resolve(this(...args)).then(" + encodeBinaryFunction + "); }";
+
+/**
+ * Remote object ids of frontend plugin methods, so calling one is a Runtime.callFunctionOn on a known 
+ * function rather than a Runtime.evaluate of freshly generated source. 
+ * 
+ * Ids die with the execution context they were created in, the whole cache is dropped when the shared context 
+ * reports its contexts destroyed or cleared, and a single entry when the browser no longer knows its id.
+ */
+class FrontendMethodCache
+{
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::string> m_objectIds;
+    /** Bumped on every invalidation, resolutions started before it aren't stored. */
+    uint64_t m_generation = 0;
+
+    static std::string Key(const std::string& pluginName, const std::string& methodName)
     {
-        std::string message = fmt::format("Millennium couldn't decode the response from {}, reason: {}", script, ex.what());
-        return PyUnicode_FromString(message.c_str());
+        return pluginName + '\0' + methodName;
     }
-    catch (std::exception&)
+
+public:
+    static FrontendMethodCache& get()
     {
-        PyErr_SetString(PyExc_ConnectionError, "frontend is not loaded!");
-        return NULL;
+        static FrontendMethodCache instance;
+        return instance;
     }
 
-    Py_RETURN_NONE;
+    std::optional<std::string> Find(const std::string& pluginName, const std::string& methodName)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_objectIds.find(Key(pluginName, methodName));
+        return it != m_objectIds.end() ? std::make_optional(it->second) : std::nullopt;
+    }
+
+    uint64_t Generation()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_generation;
+    }
+
+    void Store(const std::string& pluginName, const std::string& methodName, const std::string& objectId, uint64_t generation)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (generation == m_generation) 
+        {
+            m_objectIds[Key(pluginName, methodName)] = objectId;
+        }
+    }
+
+    void Evict(const std::string& pluginName, const std::string& methodName, const std::string& objectId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_objectIds.find(Key(pluginName, methodName));
+        if (it != m_objectIds.end() && it->second == objectId) 
+        {
+            m_objectIds.erase(it);
+        }
+    }
+
+    void Invalidate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_objectIds.clear();
+        m_generation++;
+    }
+};
+
+/**
+ * @brief Drops every cached frontend method and makes sure the cache hears about destroyed execution contexts.
+ * Called whenever Millennium attaches to a (new) SharedJSContext session, which also enables the Runtime domain there.
+ */
+MILLENNIUM void JavaScript::ResetFrontendMethodCache()
+{
+    static std::once_flag listenerRegistered;
+
+    std::call_once(listenerRegistered, []
+    {
+        JavaScript::SharedJSMessageEmitter::InstanceRef().OnMessage("msg", "FrontendMethodCache", [](const nlohmann::json& eventMessage, std::string listenerId)
+        {
+            const std::string method = eventMessage.value("method", std::string());
+
+            /** Cached handles only live in the SharedJSContext, contexts of other targets coming and going don't affect them. */
+            if ((method == "Runtime.executionContextDestroyed" || method == "Runtime.executionContextsCleared") && Sockets::IsSharedJsContextMessage(eventMessage)) 
+            {
+                FrontendMethodCache::get().Invalidate();
+            }
+        });
+    });
+
+    FrontendMethodCache::get().Invalidate();
+}
+
+/**
+ * @brief Whether a failed call failed because the remote object it targeted no longer exists.
+ */
+static bool IsStaleObjectError(const EvalResult& evalResult)
+{
+    if (evalResult.successfulCall || !evalResult.json.is_string()) 
+    {
+        return false;
+    }
+
+    const std::string& message = evalResult.json.get_ref<const std::string&>();
+    return message.find("Could not find object with given id") != std::string::npos 
+        || message.find("Cannot find context with specified id") != std::string::npos;
+}
+
+/**
+ * @brief Converts a parameter to a Runtime.CallArgument, so it reaches the frontend as a value instead of spliced in source text.
+ */
+static nlohmann::json ToCallArgument(const JavaScript::JsFunctionConstructTypes& param)
+{
+    switch (param.type)
+    {
+        case JavaScript::Types::Boolean: return { { "value", param.pluginName == "True" } };
+        case JavaScript::Types::Integer: 
+        {
+            try 
+            {
+                return { { "value", std::stoll(param.pluginName) } };
+            }
+            catch (const std::exception&) 
+            {
+                /** Out of range for int64, JavaScript numbers are doubles either way. */
+                return { { "value", std::strtod(param.pluginName.c_str(), nullptr) } };
+            }
+        }
+        default: return { { "value", param.pluginName } };
+    }
+}
+
+/**
+ * A frontend method call in flight. It may take a couple of requests (resolve, call, retry on a stale id), 
+ * `requestId` always holds the current one so it can be cancelled.
+ */
+struct FrontendMethodInvocationState
+{
+    std::string pluginName;
+    std::string methodName;
+    nlohmann::json arguments;
+    bool binaryResults;
+    EvalCallback onResult;
+
+    std::atomic<int64_t> requestId { 0 };
+    std::atomic<bool> cancelled { false };
+};
+
+static void ResolveFrontendMethod(std::shared_ptr<FrontendMethodInvocationState> invocation, bool allowRetry, bool reportSendFailure);
+
+/**
+ * @brief Sends one request on behalf of an invocation, unless it was cancelled in the meantime.
+ * Failures to send are reported through the invocation's callback when `reportSendFailure` is set and thrown otherwise.
+ */
+static void SendInvocationStep(const std::shared_ptr<FrontendMethodInvocationState>& invocation, const std::string& method, nlohmann::json params, EvalCallback onResult, bool reportSendFailure)
+{
+    if (invocation->cancelled) 
+    {
+        return;
+    }
+
+    try 
+    {
+        invocation->requestId = SendSharedJsRequest(method, std::move(params), std::move(onResult));
+    }
+    catch (const std::exception&) 
+    {
+        if (!reportSendFailure) throw;
+
+        invocation->onResult({ "__CONNECTION_ERROR__", false });
+        return;
+    }
+
+    /** Cancelled while the request was being sent, CancelRequest may have seen the previous id. */
+    if (invocation->cancelled) 
+    {
+        CancelSharedJsEvaluation(invocation->requestId);
+    }
+}
+
+/**
+ * @brief Calls an already resolved frontend method with Runtime.callFunctionOn.
+ * If the browser no longer knows the method's id (the context was torn down) it is resolved again, once.
+ */
+static void CallResolvedFrontendMethod(std::shared_ptr<FrontendMethodInvocationState> invocation, const std::string& objectId, bool allowRetry, bool reportSendFailure)
+{
+    nlohmann::json params = {
+        { "functionDeclaration", invocation->binaryResults ? callResolvedMethodBinary : callResolvedMethod },
+        { "objectId", objectId },
+        { "arguments", invocation->arguments },
+        { "awaitPromise", true },
+        { "returnByValue", true }
+    };
+
+    SendInvocationStep(invocation, "Runtime.callFunctionOn", std::move(params), [invocation, objectId, allowRetry](EvalResult evalResult) 
+    {
+        if (allowRetry && IsStaleObjectError(evalResult)) 
+        {
+            FrontendMethodCache::get().Evict(invocation->pluginName, invocation->methodName, objectId);
+            ResolveFrontendMethod(invocation, false, true);
+            return;
+        }
+        invocation->onResult(std::move(evalResult));
+    }, 
+    reportSendFailure);
+}
+
+/**
+ * @brief Resolves a plugin's frontend method to a remote object id (bound to its plugin), caches it and calls it.
+ * The lookup runs behind JavaScript::GuardFrontendLoaded, so a missing frontend is reported as usual.
+ * Send failures are thrown when called from the calling thread and reported through the callback from the socket thread.
+ */
+static void ResolveFrontendMethod(std::shared_ptr<FrontendMethodInvocationState> invocation, bool allowRetry, bool reportSendFailure)
+{
+    const std::string plugin = JavaScript::EscapeString(invocation->pluginName);
+    const std::string method = JavaScript::EscapeString(invocation->methodName);
+
+    const std::string expression = JavaScript::GuardFrontendLoaded(invocation->pluginName, fmt::format(
+        "(() => {{ const plugin = PLUGIN_LIST[\"{0}\"]; const method = plugin?.[\"{1}\"]; "
+        "if (typeof method !== 'function') throw new TypeError(\"PLUGIN_LIST['{0}'].{1} is not a function\"); "
+        "return method.bind(plugin); }})()", 
+        plugin, method
+    ));
+
+    const uint64_t generation = FrontendMethodCache::get().Generation();
+
+    SendInvocationStep(invocation, "Runtime.evaluate", {
+        { "expression", expression }, 
+        { "objectGroup", FRONTEND_METHOD_OBJECT_GROUP }
+    }, 
+    [invocation, generation, allowRetry](EvalResult evalResult) 
+    {
+        const std::string objectId = evalResult.successfulCall ? evalResult.json.value("objectId", std::string()) : std::string();
+
+        if (objectId.empty()) 
+        {
+            invocation->onResult(evalResult.successfulCall ? EvalResult { "couldn't resolve frontend method", false } : std::move(evalResult));
+            return;
+        }
+
+        FrontendMethodCache::get().Store(invocation->pluginName, invocation->methodName, objectId, generation);
+        CallResolvedFrontendMethod(invocation, objectId, allowRetry, true);
+    }, 
+    reportSendFailure);
+}
+
+/**
+ * @brief Get a StartRequest calling a plugin's frontend method with structured arguments.
+ * 
+ * The method is looked up once and then called through its cached remote object id, with the arguments passed 
+ * as Runtime.CallArguments. No source text is generated, escaped, parsed or compiled per call.
+ */
+static StartRequest FrontendMethodInvocation(std::string pluginName, std::string methodName, std::vector<JavaScript::JsFunctionConstructTypes> params, bool binaryResults)
+{
+    nlohmann::json arguments = nlohmann::json::array();
+
+    for (const auto& param : params) 
+    {
+        arguments.push_back(ToCallArgument(param));
+    }
+
+    return [pluginName = std::move(pluginName), methodName = std::move(methodName), arguments = std::move(arguments), binaryResults](EvalCallback onResult) -> CancelRequest
+    {
+        auto invocation = std::make_shared<FrontendMethodInvocationState>();
+        invocation->pluginName    = pluginName;
+        invocation->methodName    = methodName;
+        invocation->arguments     = arguments;
+        invocation->binaryResults = binaryResults;
+        invocation->onResult      = std::move(onResult);
+
+        const auto objectId = FrontendMethodCache::get().Find(pluginName, methodName);
+
+        if (objectId.has_value()) 
+            CallResolvedFrontendMethod(invocation, *objectId, true, false);
+        else
+            ResolveFrontendMethod(invocation, true, false);
+
+        return [invocation] 
+        {
+            invocation->cancelled = true;
+            CancelSharedJsEvaluation(invocation->requestId);
+        };
+    };
+}
+
+/**
+ * Decodes a value wrapped by encodeBinaryFunction straight into a `bytes` object.
+ * @returns {PyObject*} - A new reference, or NULL with a Python `ValueError` set if the payload isn't valid base64.
+ */
+static PyObject* BinaryResultToPyBytes(const std::string& encoded)
+{
+    PyObject* bytes = PyBytes_FromStringAndSize(NULL, Base64::MaxDecodedLength(encoded.size()));
+
+    if (bytes == NULL) 
+    {
+        return NULL;
+    }
+
+    const auto decodedLength = Base64::DecodeInto(encoded.data(), encoded.size(), PyBytes_AS_STRING(bytes), Base64::DecodeMode::Strict);
+
+    if (!decodedLength.has_value()) 
+    {
+        Py_DECREF(bytes);
+        PyErr_SetString(PyExc_ValueError, "frontend returned malformed binary data");
+        return NULL;
+    }
+
+    _PyBytes_Resize(&bytes, static_cast<Py_ssize_t>(*decodedLength));
+    return bytes;
+}
+
+/**
+ * @brief Python::JsonObjectHook turning objects wrapped by encodeBinaryFunction back into `bytes`.
+ */
+static bool DecodeBinaryResult(const nlohmann::json& object, PyObject*& result)
+{
+    if (object.size() != 1 || !object.contains(BINARY_RESULT_KEY) || !object[BINARY_RESULT_KEY].is_string()) 
+    {
+        return false;
+    }
+
+    result = BinaryResultToPyBytes(object[BINARY_RESULT_KEY].get_ref<const std::string&>());
+    return true;
+}
+
+/**
+ * Converts a JSON value returned by value from the frontend into the matching Python type, see Python::JsonToPyObject.
+ *
+ * @param {const nlohmann::json&} value - The value to convert.
+ * @param {bool} binaryResults - Whether objects wrapped by encodeBinaryFunction should be turned into `bytes`.
+ * @returns {PyObject*} - A new reference, or NULL with a Python exception set.
+ */
+static PyObject* JsonValueToPyObject(const nlohmann::json& value, bool binaryResults)
+{
+    return Python::JsonToPyObject(value, binaryResults ? DecodeBinaryResult : nullptr);
+}
+
+/**
+ * Converts a CDP RemoteObject, as returned with returnByValue, into a PyObject.
+ *
+ * Values JSON can't represent (NaN, ±Infinity, -0 and BigInts) are sent as `unserializableValue` and 
+ * converted to float and int respectively. Anything without a value (undefined, functions, symbols) becomes None.
+ */
+static PyObject* RemoteObjectToPyObject(const nlohmann::json& remoteObject, bool binaryResults)
+{
+    if (remoteObject.contains("unserializableValue")) 
+    {
+        std::string unserializable = remoteObject["unserializableValue"];
+
+        if (remoteObject.value("type", std::string()) == "bigint") 
+        {
+            if (!unserializable.empty() && unserializable.back() == 'n') unserializable.pop_back();
+            return PyLong_FromString(unserializable.c_str(), NULL, 10);
+        }
+
+        if (unserializable == "-0")        return PyFloat_FromDouble(-0.0);
+        if (unserializable == "Infinity")  return PyFloat_FromDouble(std::numeric_limits<double>::infinity());
+        if (unserializable == "-Infinity") return PyFloat_FromDouble(-std::numeric_limits<double>::infinity());
+
+        return PyFloat_FromDouble(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    if (remoteObject.contains("value")) 
+    {
+        return JsonValueToPyObject(remoteObject["value"], binaryResults);
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * Converts the result of a frontend evaluation into a PyObject.
+ *
+ * @param {const EvalResult&} response - The evaluation result.
+ * @param {const std::string&} script - The evaluated script, used in decode errors.
+ * @param {bool} binaryResults - Whether binary values wrapped by encodeBinaryFunction should be returned as `bytes`.
+ * @returns {PyObject*} - A new reference, or NULL with a Python exception set.
+ *
+ * JavaScript values are converted structurally, see RemoteObjectToPyObject and JsonValueToPyObject.
+ *
+ * Error Handling:
+ * - If the execution fails, a Python `RuntimeError` is raised with the provided error message.
+ * - If the frontend is not loaded, a Python `ConnectionError` is set.
+ * - If the response cannot be parsed, a Python `RuntimeError` is raised.
+ */
+static PyObject* EvalResultToPyObject(const EvalResult& response, const std::string& script, bool binaryResults)
+{
+    try 
+    {
+        if (!response.successfulCall) 
+        {
+            if (response.json == "__CONNECTION_ERROR__") 
+            {
+                PyErr_SetString(PyExc_ConnectionError, "frontend is not loaded!");
+                return NULL;
+            }
+
+            PyErr_SetString(PyExc_RuntimeError, response.json.get<std::string>().c_str());
+            return NULL;
+        }
+
+        return RemoteObjectToPyObject(response.json, binaryResults);
+    }
+    catch (nlohmann::detail::exception& ex)
+    {
+        PyErr_SetString(PyExc_RuntimeError, fmt::format("Millennium couldn't decode the response from {}, reason: {}", script, ex.what()).c_str());
+        return NULL;
+    }
+}
+
+/**
+ * Blocks on ExecuteOnSharedJsContext with the GIL released, so other Python threads keep running.
+ *
+ * @returns {bool} - false with a Python `TimeoutError` or `ConnectionError` set when no result could be obtained.
+ */
+static bool ExecuteOnSharedJsContextAllowThreads(const StartRequest& startRequest, std::chrono::milliseconds timeout, EvalResult& response)
+{
+    std::exception_ptr evaluateError;
+
+    Py_BEGIN_ALLOW_THREADS
+    try 
+    {
+        response = ExecuteOnSharedJsContext(startRequest, timeout);
+    }
+    catch (...) 
+    {
+        evaluateError = std::current_exception();
+    }
+    Py_END_ALLOW_THREADS
+
+    try 
+    {
+        if (evaluateError) 
+        {
+            std::rethrow_exception(evaluateError);
+        }
+    }
+    catch (EvaluateTimeoutError& ex)
+    {
+        PyErr_SetString(PyExc_TimeoutError, ex.what());
+        return false;
+    }
+    catch (const std::exception& ex)
+    {
+        SetFrontendCallError(ex);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Evaluates a JavaScript script via a shared socket connection and converts the result to a PyObject.
+ *
+ * @param {std::string} script - The JavaScript code to be executed.
+ * @param {std::chrono::milliseconds} timeout - How long to wait for the frontend to respond.
+ * @param {bool} binaryResults - Return binary values as `bytes`, the script must have been built with binaryResults as well.
+ * @returns {PyObject*} - A Python object representing the evaluation result, see EvalResultToPyObject.
+ *
+ * The GIL is released while waiting on the frontend, so other Python threads keep running. 
+ *
+ * Error Handling:
+ * - If the frontend doesn't respond in time, a Python `TimeoutError` is raised.
+ * - If the frontend is not loaded or Millennium is shutting down, a Python `ConnectionError` is set with the reason.
+ * - If too many calls are already waiting on frontends to load, a Python `RuntimeError` is raised.
+ */
+MILLENNIUM PyObject* JavaScript::EvaluateFromSocket(std::string script, std::chrono::milliseconds timeout, bool binaryResults)
+{
+    EvalResult response;
+
+    if (!ExecuteOnSharedJsContextAllowThreads(SharedJsEvaluation(script), timeout, response)) 
+    {
+        return NULL;
+    }
+
+    return EvalResultToPyObject(response, script, binaryResults);
+}
+
+/**
+ * Calls a plugin's frontend method and converts the result to a PyObject, see FrontendMethodInvocation.
+ *
+ * @param {std::string} pluginName - The plugin whose frontend method to call.
+ * @param {std::string} methodName - The method on the plugin's frontend.
+ * @param {std::vector<JavaScript::JsFunctionConstructTypes>} params - The arguments to call it with.
+ * @param {std::chrono::milliseconds} timeout - How long to wait for the frontend to respond.
+ * @param {bool} binaryResults - Return binary values as `bytes`.
+ * @returns {PyObject*} - A Python object representing the result, raises like EvaluateFromSocket does.
+ */
+MILLENNIUM PyObject* JavaScript::InvokeFrontendMethod(std::string pluginName, std::string methodName, std::vector<JavaScript::JsFunctionConstructTypes> params, std::chrono::milliseconds timeout, bool binaryResults)
+{
+    EvalResult response;
+    const std::string description = fmt::format("PLUGIN_LIST['{}'].{}", pluginName, methodName);
+
+    const StartRequest invocation = DeferredFrontendCalls::get().Gate(pluginName, FrontendMethodInvocation(pluginName, methodName, std::move(params), binaryResults), timeout, true);
+
+    if (!ExecuteOnSharedJsContextAllowThreads(invocation, timeout, response)) 
+    {
+        return NULL;
+    }
+
+    return EvalResultToPyObject(response, description, binaryResults);
+}
+
+/**
+ * Evaluates a script built with ConstructBatchedFunctionCall and unpacks its per call results.
+ *
+ * @param {std::string} pluginName - The plugin the batch calls into, the batch waits for its frontend like InvokeFrontendMethod does.
+ * @param {std::string} script - The batched JavaScript call.
+ * @param {std::chrono::milliseconds} timeout - How long to wait for the whole batch.
+ * @param {bool} binaryResults - Return binary values as `bytes`, the script must have been built with binaryResults as well.
+ * @returns {PyObject*} - A list with one entry per call. Successful calls hold their converted result (see EvalResultToPyObject), 
+ *                        failed ones hold the exception they would have raised, so one failing call doesn't hide the others.
+ *
+ * Error Handling:
+ * - Errors affecting the whole batch (timeout, frontend not loaded, full queue, undecodable response) are raised like EvaluateFromSocket does.
+ */
+MILLENNIUM PyObject* JavaScript::EvaluateBatchFromSocket(std::string pluginName, std::string script, std::chrono::milliseconds timeout, bool binaryResults)
+{
+    EvalResult response;
+
+    if (!ExecuteOnSharedJsContextAllowThreads(DeferredFrontendCalls::get().Gate(pluginName, SharedJsEvaluation(script), timeout, true), timeout, response)) 
+    {
+        return NULL;
+    }
+
+    if (!response.successfulCall) 
+    {
+        return EvalResultToPyObject(response, script, binaryResults);
+    }
+
+    nlohmann::json entries;
+
+    try 
+    {
+        entries = nlohmann::json::parse(response.json.at("value").get<std::string>());
+    }
+    catch (nlohmann::detail::exception& ex)
+    {
+        PyErr_SetString(PyExc_RuntimeError, fmt::format("Millennium couldn't decode the batched frontend response, reason: {}", ex.what()).c_str());
+        return NULL;
+    }
+
+    PyObject* results = PyList_New(0);
+
+    for (const auto& entry : entries) 
+    {
+        PyObject* value = entry.value("ok", false)
+            ? EvalResultToPyObject({ entry, true }, script, binaryResults)
+            : EvalResultToPyObject({ entry.value("error", "unknown error"), false }, script, binaryResults);
+
+        if (value == NULL) 
+        {
+            PyObject *type, *traceback;
+            PyErr_Fetch(&type, &value, &traceback);
+            PyErr_NormalizeException(&type, &value, &traceback);
+            Py_XDECREF(type);
+            Py_XDECREF(traceback);
+        }
+
+        PyList_Append(results, value);
+        Py_XDECREF(value);
+    }
+
+    return results;
+}
+
+/** Converts the result of an awaitable request into the value its future resolves to, runs with the plugin's GIL held. */
+using ResultConverter = std::function<PyObject*(const EvalResult&)>;
+
+/**
+ * State shared between an awaitable frontend call, its event loop callbacks and the socket listener. 
+ * Whoever flips `settled` first owns the references to `loop` and `future` and releases them.
+ */
+struct AsyncEvaluation 
+{
+    CancelRequest cancelRequest = [] {};
+    std::string pluginName;
+    ResultConverter toPyObject;
+    /** Owned references, only touched with the plugin's GIL held and released by the future's done callback. */
+    PyObject* loop        = nullptr;
+    PyObject* future      = nullptr;
+    PyObject* timerHandle = nullptr;
+    /** Set if the loop runs on an executor thread (i.e asyncio.run from an IPC call), which can't run posted work until the loop returns. */
+    std::weak_ptr<PluginExecutor> loopExecutor;
+    std::atomic<bool> settled { false };
+};
+
+/**
+ * @brief Completes an asyncio future unless it was already completed or cancelled.
+ * Always scheduled onto the future's own loop, args are (future, is_error, value).
+ */
+static PyObject* ResolveFrontendFuture(PyObject* self, PyObject* args)
+{
+    PyObject* future = NULL;
+    int isError = 0;
+    PyObject* value = NULL;
+
+    if (!PyArg_ParseTuple(args, "OpO", &future, &isError, &value)) 
+    {
+        return NULL;
+    }
+
+    PyObject* isDone = PyObject_CallMethod(future, "done", NULL);
+
+    if (isDone == NULL) 
+    {
+        return NULL;
+    }
+
+    const bool alreadyDone = PyObject_IsTrue(isDone);
+    Py_DECREF(isDone);
+
+    if (!alreadyDone) 
+    {
+        PyObject* result = PyObject_CallMethod(future, isError ? "set_exception" : "set_result", "O", value);
+
+        if (result == NULL) 
+        {
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Done callback of the future, runs however it completed (result, error, cancel, timeout).
+ * Drops the socket listener when the caller gave up first, cancels the deadline timer so it doesn't keep the 
+ * future alive until it would have fired, and releases the references the evaluation holds.
+ * `self` is a capsule holding the std::shared_ptr<AsyncEvaluation>.
+ */
+static PyObject* OnFrontendFutureDone(PyObject* self, PyObject* future)
+{
+    auto evaluation = *static_cast<std::shared_ptr<AsyncEvaluation>*>(PyCapsule_GetPointer(self, "AsyncEvaluation"));
+
+    if (!evaluation->settled.exchange(true)) 
+    {
+        evaluation->cancelRequest();
+    }
+
+    if (evaluation->timerHandle != nullptr) 
+    {
+        PyObject* cancelled = PyObject_CallMethod(evaluation->timerHandle, "cancel", NULL);
+        Py_XDECREF(cancelled);
+        PyErr_Clear();
+    }
+
+    Py_CLEAR(evaluation->timerHandle);
+    Py_CLEAR(evaluation->loop);
+    Py_CLEAR(evaluation->future);
+
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef resolveFrontendFutureDef = { "_resolve_frontend_future", (PyCFunction)ResolveFrontendFuture, METH_VARARGS, NULL };
+static PyMethodDef onFrontendFutureDoneDef  = { "_on_frontend_future_done", (PyCFunction)OnFrontendFutureDone,  METH_O,       NULL };
+
+/**
+ * Hands a frontend result to the event loop that is waiting on it. Called on the socket thread.
+ *
+ * The result is posted to the plugin's executor, like backend method calls, so the socket thread never waits 
+ * on the plugin's GIL. The future is completed through loop.call_soon_threadsafe as asyncio futures are not thread safe.
+ * 
+ * A loop running on the executor itself blocks the task that would run the post, so in that case the result is 
+ * handed over right here instead, see PluginExecutor::RunAlongside.
+ * 
+ * If the executor is gone the result is dropped. The future then fails once its deadline passes, 
+ * and its done callback releases the references like on every other path.
+ */
+static void CompleteAsyncEvaluation(std::shared_ptr<AsyncEvaluation> evaluation, EvalResult evalResult)
+{
+    /** The caller already cancelled or timed out, nothing is waiting for this anymore. */
+    if (evaluation->settled.exchange(true)) 
+    {
+        return;
+    }
+
+    const PluginExecutor::Task deliver = [evaluation, evalResult = std::move(evalResult)]
+    {
+        /** The future was cancelled while this was queued, its done callback already released everything. */
+        if (evaluation->loop == nullptr) 
+        {
+            return;
+        }
+
+        PyObject* value = evaluation->toPyObject(evalResult);
+        const bool isError = value == NULL;
+
+        if (isError) 
+        {
+            PyObject *type, *traceback;
+            PyErr_Fetch(&type, &value, &traceback);
+            PyErr_NormalizeException(&type, &value, &traceback);
+            Py_XDECREF(type);
+            Py_XDECREF(traceback);
+        }
+
+        PyObject* resolver = PyCFunction_New(&resolveFrontendFutureDef, NULL);
+        PyObject* handle = resolver && value
+            ? PyObject_CallMethod(evaluation->loop, "call_soon_threadsafe", "OOOO", resolver, evaluation->future, isError ? Py_True : Py_False, value) 
+            : NULL;
+
+        if (handle == NULL) 
+        {
+            LOG_ERROR(fmt::format("couldn't deliver frontend result to [{}], reason: {}", evaluation->pluginName, std::get<0>(Python::ActiveExceptionInformation())));
+        }
+
+        Py_XDECREF(handle);
+        Py_XDECREF(resolver);
+        Py_XDECREF(value);
+    };
+
+    bool delivered;
+
+    if (std::shared_ptr<PluginExecutor> loopExecutor = evaluation->loopExecutor.lock()) 
+    {
+        delivered = loopExecutor->RunAlongside(deliver);
+    }
+    else 
+    {
+        std::shared_ptr<PluginExecutor> executor = PythonManager::GetInstance().GetPluginExecutor(evaluation->pluginName);
+        delivered = executor && executor->Post(deliver);
+    }
+
+    if (!delivered) 
+    {
+        LOG_ERROR(fmt::format("couldn't deliver frontend result to [{}], the backend exited before it arrived.", evaluation->pluginName));
+    }
+}
+
+/**
+ * Runs a request on the browser connection without blocking the calling thread.
+ *
+ * @param {std::string} pluginName - The plugin making the call, used to re-enter its interpreter once the result arrives.
+ * @param {const StartRequest&} startRequest - The request to run.
+ * @param {std::chrono::milliseconds} timeout - How long the browser may take before the future fails with `TimeoutError`.
+ * @param {ResultConverter} toPyObject - Turns the result into the future's value, or returns NULL with the exception to fail it with set.
+ * @returns {PyObject*} - An asyncio.Future bound to the running event loop, or NULL with a Python exception set.
+ *
+ * No thread is parked on the call. The future is completed from the socket listener.
+ * Cancelling the future drops the pending listener. Must be called from a coroutine, i.e with a running loop.
+ */
+static PyObject* ExecuteRequestAsync(std::string pluginName, const StartRequest& startRequest, std::chrono::milliseconds timeout, ResultConverter toPyObject)
+{
+    PyObject* asyncioModule = PyImport_ImportModule("asyncio");
+
+    if (asyncioModule == NULL) 
+    {
+        return NULL;
+    }
+
+    PyObject* loop = PyObject_CallMethod(asyncioModule, "get_running_loop", NULL);
+    Py_DECREF(asyncioModule);
+
+    if (loop == NULL) 
+    {
+        return NULL;
+    }
+
+    PyObject* future = PyObject_CallMethod(loop, "create_future", NULL);
+
+    if (future == NULL) 
+    {
+        Py_DECREF(loop);
+        return NULL;
+    }
+
+    auto evaluation = std::make_shared<AsyncEvaluation>();
+    evaluation->pluginName = pluginName;
+    evaluation->toPyObject = std::move(toPyObject);
+    evaluation->loop       = loop;   /** steals the references from above, released by the done callback. */
+    evaluation->future     = future;
+    Py_INCREF(future);               /** ...and one more for our caller. */
+    evaluation->loopExecutor = PluginExecutor::Current();
+
+    PyObject* capsule = PyCapsule_New(new std::shared_ptr<AsyncEvaluation>(evaluation), "AsyncEvaluation", [](PyObject* capsule) 
+    {
+        delete static_cast<std::shared_ptr<AsyncEvaluation>*>(PyCapsule_GetPointer(capsule, "AsyncEvaluation"));
+    });
+
+    PyObject* doneCallback = capsule ? PyCFunction_New(&onFrontendFutureDoneDef, capsule) : NULL;
+    Py_XDECREF(capsule);
+
+    PyObject* registered = doneCallback ? PyObject_CallMethod(future, "add_done_callback", "O", doneCallback) : NULL;
+    Py_XDECREF(doneCallback);
+
+    if (registered == NULL) 
+    {
+        evaluation->settled = true;
+        Py_CLEAR(evaluation->loop);
+        Py_CLEAR(evaluation->future);
+        Py_DECREF(future);
+        return NULL;
+    }
+    Py_DECREF(registered);
+
+    /** Fail the future once the deadline passes, the done callback then drops the listener. The handle is kept so the done callback can cancel it. */
+    PyObject* timeoutError = PyObject_CallFunction(PyExc_TimeoutError, "s", fmt::format("frontend didn't respond within {}ms", timeout.count()).c_str());
+    PyObject* resolver = PyCFunction_New(&resolveFrontendFutureDef, NULL);
+    PyObject* timerHandle = timeoutError && resolver 
+        ? PyObject_CallMethod(loop, "call_later", "dOOOO", std::chrono::duration<double>(timeout).count(), resolver, future, Py_True, timeoutError) 
+        : NULL;
+
+    Py_XDECREF(timeoutError);
+    Py_XDECREF(resolver);
+
+    if (timerHandle == NULL) 
+    {
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+
+        PyObject* cancelled = PyObject_CallMethod(future, "cancel", NULL);
+        Py_XDECREF(cancelled);
+        Py_DECREF(future);
+
+        PyErr_Restore(type, value, traceback);
+        return NULL;
+    }
+    evaluation->timerHandle = timerHandle;
+
+    try 
+    {
+        evaluation->cancelRequest = startRequest([evaluation](EvalResult evalResult) 
+        {
+            CompleteAsyncEvaluation(evaluation, std::move(evalResult));
+        });
+    }
+    catch (const std::exception& ex)
+    {
+        PyObject* cancelled = PyObject_CallMethod(future, "cancel", NULL);
+        Py_XDECREF(cancelled);
+        Py_DECREF(future);
+
+        SetFrontendCallError(ex);
+        return NULL;
+    }
+
+    return future;
+}
+
+/**
+ * Awaitable variant of JavaScript::InvokeFrontendMethod, see ExecuteRequestAsync. 
+ * The future resolves to the same values InvokeFrontendMethod returns and fails with the same exceptions it raises.
+ */
+MILLENNIUM PyObject* JavaScript::InvokeFrontendMethodAsync(std::string pluginName, std::string methodName, std::vector<JavaScript::JsFunctionConstructTypes> params, std::chrono::milliseconds timeout, bool binaryResults)
+{
+    const std::string description = fmt::format("PLUGIN_LIST['{}'].{}", pluginName, methodName);
+    const StartRequest invocation = DeferredFrontendCalls::get().Gate(pluginName, FrontendMethodInvocation(pluginName, methodName, std::move(params), binaryResults), timeout, false);
+
+    return ExecuteRequestAsync(pluginName, invocation, timeout, [description, binaryResults](const EvalResult& evalResult) 
+    {
+        return EvalResultToPyObject(evalResult, description, binaryResults);
+    });
+}
+
+/**
+ * @brief Get a StartRequest sending a raw CDP command over the browser connection.
+ * @param {std::optional<std::string>} sessionId - The attached target to send it to, the browser itself when empty.
+ *
+ * The result is passed on untouched, protocol errors are passed on as their message with `successfulCall` unset.
+ */
+static StartRequest BrowserCommand(std::string method, nlohmann::json params, std::optional<std::string> sessionId)
+{
+    return [method = std::move(method), params = std::move(params), sessionId = std::move(sessionId)](EvalCallback onResult) -> CancelRequest
+    {
+        const int64_t requestId = sharedJsEvaluateId.fetch_add(1, std::memory_order_relaxed);
+
+        auto& emitter = JavaScript::SharedJSMessageEmitter::InstanceRef();
+        emitter.OnResponse(requestId, [onResult](const nlohmann::json& response) 
+        {
+            if (response.contains("error")) 
+                onResult({ response["error"].value("message", std::string("unknown protocol error")), false });
+            else
+                onResult({ response.value("result", nlohmann::json::object()), true });
+        });
+
+        nlohmann::json message = { { "id", requestId }, { "method", method }, { "params", params } };
+
+        if (sessionId.has_value()) 
+        {
+            message["sessionId"] = *sessionId;
+        }
+
+        if (!Sockets::PostGlobal(std::move(message))) 
+        {
+            emitter.RemoveResponseHandler(requestId);
+            throw std::runtime_error("couldn't send message to socket");
+        }
+
+        return [requestId] { CancelSharedJsEvaluation(requestId); };
+    };
+}
+
+/**
+ * Sends a raw CDP command over Millennium's browser connection and returns an awaitable for its result, see ExecuteRequestAsync.
+ *
+ * @param {std::string} pluginName - The plugin sending the command.
+ * @param {std::string} method - The CDP method, i.e Page.captureScreenshot.
+ * @param {nlohmann::json} params - The method parameters.
+ * @param {std::optional<std::string>} sessionId - The attached target to send it to, the browser itself when empty.
+ * @param {std::chrono::milliseconds} timeout - How long the browser may take before the future fails with `TimeoutError`.
+ * @returns {PyObject*} - An asyncio.Future resolving to the command's result as native Python values, 
+ *                        protocol errors fail it with a `RuntimeError`.
+ */
+MILLENNIUM PyObject* JavaScript::SendBrowserCommandAsync(std::string pluginName, std::string method, nlohmann::json params, std::optional<std::string> sessionId, std::chrono::milliseconds timeout)
+{
+    return ExecuteRequestAsync(pluginName, BrowserCommand(method, std::move(params), std::move(sessionId)), timeout, [method](const EvalResult& evalResult) -> PyObject*
+    {
+        if (!evalResult.successfulCall) 
+        {
+            PyErr_SetString(PyExc_RuntimeError, fmt::format("{} failed: {}", method, evalResult.json.is_string() ? evalResult.json.get<std::string>() : evalResult.json.dump()).c_str());
+            return NULL;
+        }
+
+        return JsonValueToPyObject(evalResult.json, false);
+    });
 }
@@ -0,0 +1,184 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * backend_events.cc
+ *
+ * Delivers Runtime.bindingCalled events from the SharedJSContext to plugin backends, see BackendEventChannel.
+ */
+#include "backend_events.h"
+#include "backend_worker.h"
+#include "co_spawn.h"
+#include "loader.h"
+#include "ffi.h"
+#include "plugin_logger.h"
+#include "internal_logger.h"
+#include "fvisible.h"
+
+enum BackendEventMessageId
+{
+    BACKEND_EVENT_ADD_BINDING = 8675309
+};
+
+MILLENNIUM BackendEventChannel& BackendEventChannel::get()
+{
+    static BackendEventChannel instance;
+    return instance;
+}
+
+/**
+ * @brief Install the binding on the current SharedJSContext session.
+ * Bindings survive navigations of the target, so this only has to happen once per session.
+ */
+MILLENNIUM void BackendEventChannel::Attach()
+{
+    Sockets::PostShared({
+        { "id", BACKEND_EVENT_ADD_BINDING },
+        { "method", "Runtime.addBinding" },
+        { "params", { { "name", BINDING_NAME } } }
+    });
+}
+
+/**
+ * @brief Picks binding calls out of the browser socket traffic. Runs on the socket thread, so it only parses and hands them on.
+ */
+MILLENNIUM void BackendEventChannel::DispatchSocketMessage(const nlohmann::json& message)
+{
+    if (message.value("method", std::string()) != "Runtime.bindingCalled") 
+    {
+        return;
+    }
+
+    /** Plugins can add bindings to other targets through the DevTools passthrough, only the SharedJSContext may call backends. */
+    if (!Sockets::IsSharedJsContextMessage(message)) 
+    {
+        return;
+    }
+
+    const auto& params = message["params"];
+
+    if (params.value("name", std::string()) != BINDING_NAME) 
+    {
+        return;
+    }
+
+    nlohmann::json call = nlohmann::json::parse(params.value("payload", std::string()), nullptr, false);
+
+    if (call.is_discarded() || !call.is_object() || !call.contains("pluginName") || !call["pluginName"].is_string() || !call.contains("methodName") || !call["methodName"].is_string()) 
+    {
+        LOG_ERROR("Ignoring malformed backend event, expected {{ pluginName, methodName, argumentList }} got: {}", params.value("payload", std::string()));
+        return;
+    }
+
+    const std::string pluginName = call["pluginName"];
+    this->Dispatch(pluginName, std::move(call));
+}
+
+/**
+ * @brief Hand an event to the plugin's backend without waiting for it, unless the backend is too far behind already.
+ */
+MILLENNIUM void BackendEventChannel::Dispatch(const std::string& pluginName, nlohmann::json call)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_stop.load()) 
+        {
+            return;
+        }
+
+        PluginBacklog& backlog = m_backlogs[pluginName];
+
+        if (backlog.queuedEvents >= MAX_QUEUED_EVENTS) 
+        {
+            /** Don't flood the log when a backend is stuck, report the first drop and then every thousandth. */
+            if (backlog.droppedEvents++ % 1000 == 0) 
+            {
+                Logger.Warn("[{}] is {} backend events behind, dropped {} event(s) so far. Its backend is likely blocking.", pluginName, MAX_QUEUED_EVENTS, backlog.droppedEvents);
+            }
+            return;
+        }
+        backlog.queuedEvents++;
+    }
+
+    const std::string methodName = call["methodName"];
+    const auto onResult = [this, pluginName, methodName](const Python::EvalResult& result) 
+    {
+        this->Complete(pluginName, methodName, result);
+    };
+
+    bool dispatched = false;
+
+    if (std::shared_ptr<BackendWorker> worker = BackendWorkers::get().Find(pluginName)) 
+    {
+        dispatched = worker->InvokeAsync(call, onResult);
+    }
+    else if (std::shared_ptr<PluginExecutor> executor = PythonManager::GetInstance().GetPluginExecutor(pluginName)) 
+    {
+        dispatched = executor->Post([this, pluginName, call = std::move(call), onResult] 
+        {
+            /** Runs inline, we are on the plugin's executor already. */
+            onResult(m_stop.load() ? Python::EvalResult { "false", Python::Boolean } : Python::LockGILAndInvokeMethod(pluginName, call));
+        });
+    }
+
+    /** The plugin has no backend running, the event goes nowhere like it would have before the backend was around. */
+    if (!dispatched) 
+    {
+        this->Complete(pluginName, methodName, { "false", Python::Boolean });
+    }
+}
+
+/**
+ * @brief Called once the backend handled an event, on its executor or on the thread supervising its worker.
+ */
+MILLENNIUM void BackendEventChannel::Complete(const std::string& pluginName, const std::string& methodName, const Python::EvalResult& result)
+{
+    if (result.type == Python::Types::Error) 
+    {
+        ErrorToLogger(pluginName, fmt::format("Backend event {} failed: {}", methodName, result.plain));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto backlog = m_backlogs.find(pluginName);
+
+    if (backlog != m_backlogs.end() && backlog->second.queuedEvents > 0) 
+    {
+        backlog->second.queuedEvents--;
+    }
+}
+
+/**
+ * @brief Stop dispatching, events still queued on executors are dropped when they come up.
+ */
+MILLENNIUM void BackendEventChannel::Shutdown()
+{
+    m_stop = true;
+}
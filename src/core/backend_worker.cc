@@ -0,0 +1,795 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * backend_worker.cc
+ *
+ * Runs plugin backends that opted into it in a separate process and relays calls to and from it, see BackendWorker.
+ */
+#include "backend_worker.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <fmt/core.h>
+#include <iostream>
+#include "co_spawn.h"
+#include "co_stub.h"
+#include "env.h"
+#include "internal_logger.h"
+#include "plugin_logger.h"
+#include "fvisible.h"
+#ifndef _WIN32
+#include <csignal>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace
+{
+    /** How long a worker gets to run plugin._unload() and exit before it is killed. */
+    constexpr auto UNLOAD_TIMEOUT = std::chrono::seconds(5);
+    /** A worker that stayed up this long is considered healthy again, and gets a fresh set of restarts. */
+    constexpr auto HEALTHY_UPTIME = std::chrono::minutes(1);
+
+    std::string JoinHandles(const std::vector<ShmHandle>& handles)
+    {
+        std::string joined;
+
+        for (const ShmHandle handle : handles)
+        {
+            if (!joined.empty()) joined.push_back(',');
+            #ifdef _WIN32
+            joined.append(std::to_string(reinterpret_cast<uintptr_t>(handle)));
+            #else
+            joined.append(std::to_string(handle));
+            #endif
+        }
+        return joined;
+    }
+
+    /**
+     * @brief Call a function of the `Millennium` module on behalf of a worker, with the proxy interpreter's GIL held.
+     * 
+     * @param {nlohmann::json} message - The worker's request, with `method`, `args` and `kwargs`.
+     * @returns {nlohmann::json} - The api_result message to send back.
+     */
+    nlohmann::json CallMillenniumApi(const nlohmann::json& message)
+    {
+        nlohmann::json response = { { "type", "api_result" }, { "id", message.value("id", 0ull) } };
+
+        const std::string method = message.value("method", std::string());
+        const nlohmann::json args = message.value("args", nlohmann::json::array());
+        const nlohmann::json kwargs = message.value("kwargs", nlohmann::json::object());
+
+        PyObject* module = PyImport_ImportModule("Millennium");
+        PyObject* function = module ? PyObject_GetAttrString(module, method.c_str()) : nullptr;
+        PyObject* argsList = function ? Python::JsonToPyObject(args) : nullptr;
+        PyObject* argsTuple = argsList ? PySequence_Tuple(argsList) : nullptr;
+        PyObject* kwargsDict = argsTuple && !kwargs.empty() ? Python::JsonToPyObject(kwargs) : nullptr;
+
+        PyObject* result = nullptr;
+        if (argsTuple && (kwargs.empty() || kwargsDict))
+        {
+            result = PyObject_Call(function, argsTuple, kwargsDict);
+        }
+
+        nlohmann::json value;
+        if (result && Python::PyObjectToJson(result, value))
+        {
+            response["ok"] = true;
+            response["value"] = std::move(value);
+        }
+        else 
+        {
+            const auto [errorMessage, traceback] = Python::ActiveExceptionInformation();
+
+            response["ok"] = false;
+            response["error"] = errorMessage;
+        }
+
+        Py_XDECREF(result);
+        Py_XDECREF(kwargsDict);
+        Py_XDECREF(argsTuple);
+        Py_XDECREF(argsList);
+        Py_XDECREF(function);
+        Py_XDECREF(module);
+        return response;
+    }
+}
+
+MILLENNIUM BackendWorker::BackendWorker(SettingsStore::PluginTypeSchema plugin, std::shared_ptr<PluginExecutor> executor)
+    : m_plugin(std::move(plugin)), m_executor(std::move(executor))
+{ }
+
+MILLENNIUM BackendWorker::~BackendWorker()
+{
+    this->Stop();
+}
+
+/**
+ * @brief Launch the worker process and start supervising it.
+ * The process is launched from the supervisor thread, which outlives it (see Spawn), this only waits for the outcome.
+ * 
+ * @returns {bool} - False if the process couldn't be launched, the plugin's backend is then considered failed.
+ */
+MILLENNIUM bool BackendWorker::Start()
+{
+    std::promise<bool> spawned;
+    std::future<bool> spawnResult = spawned.get_future();
+
+    m_supervisor = std::thread(&BackendWorker::Supervise, this, std::move(spawned));
+
+    if (!spawnResult.get()) 
+    {
+        m_supervisor.join();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Ask the worker to unload the plugin and exit, and wait until it did or was killed.
+ * Calls still waiting on the worker fail.
+ */
+MILLENNIUM void BackendWorker::Stop()
+{
+    if (!m_stopping.exchange(true)) 
+    {
+        this->Send({ { "type", "unload" } }, UNLOAD_TIMEOUT);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopCondition.notify_all();
+        }
+    }
+
+    if (m_supervisor.joinable() && m_supervisor.get_id() != std::this_thread::get_id()) 
+    {
+        m_supervisor.join();
+    }
+}
+
+/**
+ * @brief Call a backend method of the plugin in the worker and wait for its result.
+ * 
+ * @param {nlohmann::json} functionCall - The call, containing `methodName` and optionally `argumentList`.
+ * @returns {std::optional<Python::EvalResult>} - std::nullopt if the worker is stopped. A worker that dies while 
+ * the call is running fails the call with an error result.
+ */
+MILLENNIUM std::optional<Python::EvalResult> BackendWorker::Invoke(const nlohmann::json& functionCall)
+{
+    auto result = std::make_shared<std::promise<Python::EvalResult>>();
+    std::future<Python::EvalResult> resultFuture = result->get_future();
+    uint64_t invokeId;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_stopping.load() || !m_channel) 
+        {
+            return std::nullopt;
+        }
+
+        invokeId = m_nextInvokeId++;
+        m_pendingInvokes[invokeId] = [result](Python::EvalResult evalResult) { result->set_value(std::move(evalResult)); };
+    }
+
+    if (!this->Send({ { "type", "invoke" }, { "id", invokeId }, { "call", functionCall } })) 
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        /** Unless the worker died in the meantime and the call was already failed. */
+        if (m_pendingInvokes.erase(invokeId)) 
+        {
+            return Python::EvalResult { "the backend process didn't accept the call, it is either too large or the process stopped responding", Python::Error };
+        }
+    }
+    return resultFuture.get();
+}
+
+/**
+ * @brief Call a backend method of the plugin in the worker without waiting for it.
+ * 
+ * @param {nlohmann::json} functionCall - The call, containing `methodName` and optionally `argumentList`.
+ * @param {InvokeCallback} onResult - Called once with the result on the supervisor thread, or with an error result if the worker dies first.
+ * @returns {bool} - false if the call wasn't sent (the worker is stopped, or its channel is full), `onResult` is never called then.
+ */
+MILLENNIUM bool BackendWorker::InvokeAsync(const nlohmann::json& functionCall, InvokeCallback onResult)
+{
+    uint64_t invokeId;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_stopping.load() || !m_channel) 
+        {
+            return false;
+        }
+
+        invokeId = m_nextInvokeId++;
+        m_pendingInvokes[invokeId] = std::move(onResult);
+    }
+
+    /** Never waits for room in the channel, callers are on threads that must not block on the worker. */
+    if (!this->Send({ { "type", "invoke" }, { "id", invokeId }, { "call", functionCall } }, std::chrono::milliseconds(0))) 
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pendingInvokes.erase(invokeId) == 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Let the worker call `plugin._front_end_loaded()`. A restarted worker is told again once it is back up.
+ */
+MILLENNIUM void BackendWorker::NotifyFrontendLoaded()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frontendLoaded = true;
+    }
+    this->Send({ { "type", "frontend_loaded" } });
+}
+
+MILLENNIUM bool BackendWorker::Send(const nlohmann::json& message, std::chrono::milliseconds timeout)
+{
+    std::shared_ptr<ShmChannel> channel;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        channel = m_channel;
+    }
+    return channel && channel->Send(message.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace), timeout);
+}
+
+/**
+ * @brief Launch a worker process on a fresh channel, replacing the previous one.
+ * @note Only called on the supervisor thread, on Linux the worker is killed when the thread that launched it exits.
+ */
+MILLENNIUM bool BackendWorker::Spawn()
+{
+    const std::string workerPath = GetEnv("MILLENNIUM__BACKEND_WORKER_PATH");
+
+    if (!std::filesystem::exists(workerPath)) 
+    {
+        LOG_ERROR("couldn't find the backend process executable at '{}', can't start '{}'", workerPath, m_plugin.pluginName);
+        return false;
+    }
+
+    std::shared_ptr<ShmChannel> channel = ShmChannel::Create(RING_SIZE);
+
+    if (!channel) 
+    {
+        LOG_ERROR("couldn't create a channel to the backend process of '{}'", m_plugin.pluginName);
+        return false;
+    }
+
+    const std::vector<ShmHandle> handles = channel->GetInheritableHandles();
+
+    std::vector<std::string> arguments = 
+    {
+        workerPath,
+        "--plugin",        m_plugin.pluginName,
+        "--main",          m_plugin.backendAbsoluteDirectory.generic_string(),
+        "--base",          m_plugin.pluginBaseDirectory.generic_string(),
+        "--file",          (m_plugin.backendAbsoluteDirectory / "main.py").generic_string(),
+        "--home",          pythonPath,
+        "--module-path",   pythonPath,
+        "--module-path",   pythonLibs,
+        "--module-path",   pythonUserLibs,
+        "--site-packages", pythonUserLibs,
+        "--pycache",       pythonBytecodeCache,
+        "--ring-size",     std::to_string(RING_SIZE),
+        "--channel",       JoinHandles(handles)
+    };
+
+    #ifdef _WIN32
+    {
+        std::wstring commandLine;
+
+        for (const std::string& argument : arguments) 
+        {
+            if (!commandLine.empty()) commandLine.push_back(L' ');
+            commandLine.append(L"\"" + std::filesystem::u8path(argument).wstring() + L"\"");
+        }
+
+        SIZE_T attributeListSize = 0;
+        InitializeProcThreadAttributeList(nullptr, 1, 0, &attributeListSize);
+
+        std::vector<char> attributeListBuffer(attributeListSize);
+        LPPROC_THREAD_ATTRIBUTE_LIST attributeList = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attributeListBuffer.data());
+
+        /** Only hand the channel to the worker, not every inheritable handle Steam happens to have open. */
+        std::vector<HANDLE> inheritedHandles = handles;
+        InitializeProcThreadAttributeList(attributeList, 1, 0, &attributeListSize);
+        UpdateProcThreadAttribute(attributeList, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST, inheritedHandles.data(), inheritedHandles.size() * sizeof(HANDLE), nullptr, nullptr);
+
+        STARTUPINFOEXW startupInfo {};
+        startupInfo.StartupInfo.cb = sizeof(startupInfo);
+        startupInfo.lpAttributeList = attributeList;
+
+        PROCESS_INFORMATION processInfo {};
+        const std::wstring applicationName = std::filesystem::u8path(workerPath).wstring();
+
+        const BOOL created = CreateProcessW(applicationName.c_str(), commandLine.data(), nullptr, nullptr, TRUE, 
+            EXTENDED_STARTUPINFO_PRESENT | CREATE_NO_WINDOW, nullptr, nullptr, &startupInfo.StartupInfo, &processInfo);
+
+        DeleteProcThreadAttributeList(attributeList);
+
+        if (!created) 
+        {
+            LOG_ERROR("couldn't start the backend process of '{}' from {}, error {}", m_plugin.pluginName, workerPath, GetLastError());
+            return false;
+        }
+
+        /** Workers are killed along with Steam when the job handle is closed on exit, however Steam goes down. */
+        static HANDLE workerJob = []
+        {
+            HANDLE job = CreateJobObjectW(nullptr, nullptr);
+            JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits {};
+            limits.BasicLimitInformation.LimitFlags = JOB_OBJECT_LIMIT_KILL_ON_JOB_CLOSE;
+
+            SetInformationJobObject(job, JobObjectExtendedLimitInformation, &limits, sizeof(limits));
+            return job;
+        }();
+
+        AssignProcessToJobObject(workerJob, processInfo.hProcess);
+        CloseHandle(processInfo.hThread);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_process = processInfo.hProcess;
+        m_channel = std::move(channel);
+    }
+    #else
+    {
+        std::vector<char*> argv;
+        for (std::string& argument : arguments) argv.push_back(argument.data());
+        argv.push_back(nullptr);
+
+        /** Millennium is preloaded into Steam, the worker must not load it again. */
+        std::vector<char*> envp;
+        for (char** variable = environ; *variable != nullptr; variable++) 
+        {
+            if (strncmp(*variable, "LD_PRELOAD=", 11) != 0) envp.push_back(*variable);
+        }
+        envp.push_back(nullptr);
+
+        const pid_t pid = fork();
+
+        if (pid < 0) 
+        {
+            LOG_ERROR("couldn't fork the backend process of '{}': {}", m_plugin.pluginName, strerror(errno));
+            return false;
+        }
+
+        if (pid == 0) 
+        {
+            /** Only async signal safe calls from here on, none of Steam's other threads exist in the child. */
+            for (const int handle : handles) fcntl(handle, F_SETFD, 0);
+
+            #ifdef __linux__
+            /** Bound to the forking thread, Spawn only ever runs on the supervisor thread, which lives until the worker has exited. */
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            #endif
+
+            execve(argv[0], argv.data(), envp.data());
+            _exit(127);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_process = pid;
+        m_channel = std::move(channel);
+    }
+    #endif
+
+    Logger.Log("Started backend process of '{}'", m_plugin.pluginName);
+    return true;
+}
+
+MILLENNIUM bool BackendWorker::HasExited(int& exitCode)
+{
+    if (!m_process.has_value()) 
+    {
+        return true;
+    }
+
+    #ifdef _WIN32
+    {
+        if (WaitForSingleObject(*m_process, 0) != WAIT_OBJECT_0) 
+        {
+            return false;
+        }
+
+        DWORD status = 0;
+        GetExitCodeProcess(*m_process, &status);
+        CloseHandle(*m_process);
+        exitCode = static_cast<int>(status);
+    }
+    #else
+    {
+        int status = 0;
+        if (waitpid(*m_process, &status, WNOHANG) != *m_process) 
+        {
+            return false;
+        }
+        exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    }
+    #endif
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_process.reset();
+    return true;
+}
+
+MILLENNIUM void BackendWorker::Kill()
+{
+    if (!m_process.has_value()) 
+    {
+        return;
+    }
+
+    #ifdef _WIN32
+    TerminateProcess(*m_process, 1);
+    #else
+    kill(*m_process, SIGKILL);
+    #endif
+}
+
+/**
+ * @brief Relay messages from the worker until it has exited for good, restarting it if it died on its own.
+ * 
+ * This is the only thread that launches, reaps or replaces the worker process.
+ * 
+ * @param {std::promise<bool>} spawned - Receives whether the first launch succeeded, supervision ends right away if it didn't.
+ */
+MILLENNIUM void BackendWorker::Supervise(std::promise<bool> spawned)
+{
+    const bool isRunning = this->Spawn();
+    spawned.set_value(isRunning);
+
+    if (!isRunning) 
+    {
+        return;
+    }
+
+    int restarts = 0;
+    auto spawnTime = std::chrono::steady_clock::now();
+    std::optional<std::chrono::steady_clock::time_point> unloadDeadline;
+    /** The channel the worker was killed over, so a corrupt channel is only reported once. */
+    std::shared_ptr<ShmChannel> corruptChannel;
+
+    std::string message;
+
+    while (true) 
+    {
+        std::shared_ptr<ShmChannel> channel;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            channel = m_channel;
+        }
+
+        if (m_stopping.load() && !unloadDeadline.has_value()) 
+        {
+            unloadDeadline = std::chrono::steady_clock::now() + UNLOAD_TIMEOUT;
+        }
+
+        if (channel->Receive(message, std::chrono::milliseconds(250))) 
+        {
+            this->HandleMessage(nlohmann::json::parse(message, nullptr, false));
+            continue;
+        }
+
+        if (channel->IsBroken() && corruptChannel != channel) 
+        {
+            LOG_ERROR("backend process of '{}' corrupted its message channel, killing it", m_plugin.pluginName);
+            ErrorToLogger(m_plugin.pluginName, "The backend process sent a malformed message and was stopped.");
+
+            corruptChannel = channel;
+            this->Kill();
+        }
+
+        int exitCode = 0;
+
+        if (!this->HasExited(exitCode)) 
+        {
+            if (unloadDeadline.has_value() && std::chrono::steady_clock::now() > *unloadDeadline) 
+            {
+                Logger.Warn("'{}' refused to shutdown properly, force shutting down plugin...", m_plugin.pluginName);
+                ErrorToLogger(m_plugin.pluginName, "Failed to shut down plugin properly, force shutting down plugin...");
+
+                this->Kill();
+                unloadDeadline = std::chrono::steady_clock::time_point::max();
+            }
+            continue;
+        }
+
+        /** Whatever the worker managed to send before it went away, i.e its last words on stderr. */
+        while (channel->Receive(message, std::chrono::milliseconds(0))) 
+        {
+            this->HandleMessage(nlohmann::json::parse(message, nullptr, false));
+        }
+
+        if (m_stopping.load()) 
+        {
+            this->FailPendingInvokes("the plugin's backend was unloaded");
+            break;
+        }
+
+        this->FailPendingInvokes(fmt::format("the plugin's backend process exited with code {}", exitCode));
+
+        if (std::chrono::steady_clock::now() - spawnTime > HEALTHY_UPTIME) 
+        {
+            restarts = 0;
+        }
+
+        if (++restarts > MAX_RESTARTS) 
+        {
+            LOG_ERROR("backend process of '{}' exited with code {} and crashed too often, giving up on it", m_plugin.pluginName, exitCode);
+            ErrorToLogger(m_plugin.pluginName, fmt::format("The backend process crashed {} times in a row and won't be restarted again.", MAX_RESTARTS));
+            break;
+        }
+
+        const auto backoff = std::min<std::chrono::milliseconds>(std::chrono::milliseconds(500) * (1 << (restarts - 1)), std::chrono::seconds(30));
+
+        Logger.Warn("backend process of '{}' exited with code {}, restarting it in {}ms ({}/{})", m_plugin.pluginName, exitCode, backoff.count(), restarts, MAX_RESTARTS);
+        ErrorToLogger(m_plugin.pluginName, fmt::format("The backend process exited unexpectedly with code {}, restarting it...", exitCode));
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (m_stopCondition.wait_for(lock, backoff, [this] { return m_stopping.load(); })) 
+            {
+                break;
+            }
+        }
+
+        if (!this->Spawn()) 
+        {
+            break;
+        }
+        spawnTime = std::chrono::steady_clock::now();
+
+        bool frontendLoaded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            frontendLoaded = m_frontendLoaded;
+        }
+
+        if (frontendLoaded) 
+        {
+            this->Send({ { "type", "frontend_loaded" } });
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_channel.reset();
+}
+
+MILLENNIUM void BackendWorker::HandleMessage(const nlohmann::json& message)
+{
+    if (!message.is_object()) 
+    {
+        return;
+    }
+
+    const std::string type = message.value("type", std::string());
+
+    if (type == "invoke_result") 
+    {
+        InvokeCallback onResult;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto pending = m_pendingInvokes.find(message.value("id", 0ull));
+
+            if (pending == m_pendingInvokes.end()) 
+            {
+                return;
+            }
+
+            onResult = std::move(pending->second);
+            m_pendingInvokes.erase(pending);
+        }
+
+        onResult({ message.value("plain", std::string()), static_cast<Python::Types>(message.value("returnType", static_cast<int>(Python::Unknown))) });
+    }
+    else if (type == "api") 
+    {
+        this->HandleApiCall(message);
+    }
+    else if (type == "output") 
+    {
+        /** The worker's stdout and stderr, shown the same way as an in process plugin's (see bind_stdout.h). */
+        const std::string text = message.value("message", std::string());
+
+        if (message.value("stream", std::string()) == "stderr") 
+        {
+            std::cout << COL_RED << text << COL_RESET;
+            std::cout.flush();
+
+            ErrorToLogger(m_plugin.pluginName, text);
+        }
+        else if (text != "\n" && text != " ") 
+        {
+            Logger.LogPluginMessage(m_plugin.pluginName, text);
+            InfoToLogger(m_plugin.pluginName, text);
+        }
+    }
+    else if (type == "logger") 
+    {
+        /** PluginUtils.Logger calls, replayed on the proxy interpreter so they land in the plugin's own log. */
+        const std::string level = message.value("level", std::string());
+
+        if (level != "log" && level != "warn" && level != "error") 
+        {
+            return;
+        }
+
+        m_executor->Post([level, text = message.value("message", std::string())]
+        {
+            PyObject* module = PyImport_ImportModule("PluginUtils");
+            PyObject* logger = module ? PyObject_CallMethod(module, "Logger", nullptr) : nullptr;
+            PyObject* result = logger ? PyObject_CallMethod(logger, level.c_str(), "s", text.c_str()) : nullptr;
+
+            if (!result) 
+            {
+                PyErr_Clear();
+            }
+
+            Py_XDECREF(result);
+            Py_XDECREF(logger);
+            Py_XDECREF(module);
+        });
+    }
+    else if (type == "load_failed") 
+    {
+        const std::string reason = message.value("message", std::string());
+
+        Logger.PrintMessage(" PY-MAN ", fmt::format("Millennium failed to start {}: {}\n{}{}", m_plugin.pluginName, COL_RED, reason, COL_RESET), COL_RED);
+        ErrorToLogger(m_plugin.pluginName, fmt::format("Failed to start plugin: {}.\n\n{}", m_plugin.pluginName, reason));
+
+        CoInitializer::BackendCallbacks::getInstance().BackendLoaded({ m_plugin.pluginName, CoInitializer::BackendCallbacks::BACKEND_LOAD_FAILED });
+    }
+}
+
+/**
+ * @brief Run a `Millennium` API call the worker made on the plugin's proxy interpreter, and send the result back.
+ * The proxy interpreter carries the plugin's name, so the API behaves as if the plugin had called it in process.
+ */
+MILLENNIUM void BackendWorker::HandleApiCall(const nlohmann::json& message)
+{
+    std::shared_ptr<ShmChannel> channel;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        channel = m_channel;
+    }
+
+    const bool posted = m_executor->Post([channel, message]
+    {
+        channel->Send(CallMillenniumApi(message).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+    });
+
+    if (!posted) 
+    {
+        channel->Send(nlohmann::json({ 
+            { "type", "api_result" }, { "id", message.value("id", 0ull) }, { "ok", false }, { "error", "the plugin is shutting down" } 
+        }).dump());
+    }
+}
+
+MILLENNIUM void BackendWorker::FailPendingInvokes(const std::string& reason)
+{
+    std::unordered_map<uint64_t, InvokeCallback> pendingInvokes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pendingInvokes.swap(m_pendingInvokes);
+    }
+
+    for (auto& [invokeId, onResult] : pendingInvokes) 
+    {
+        onResult({ reason, Python::Error });
+    }
+}
+
+MILLENNIUM BackendWorkers& BackendWorkers::get()
+{
+    static BackendWorkers instance;
+    return instance;
+}
+
+/**
+ * @brief Whether the plugin asked for its backend to run in its own process, with `"backendHost": "process"` in its plugin.json.
+ */
+MILLENNIUM bool BackendWorkers::IsOutOfProcess(const SettingsStore::PluginTypeSchema& plugin)
+{
+    const auto backendHost = plugin.pluginJson.find("backendHost");
+    return backendHost != plugin.pluginJson.end() && backendHost->is_string() && backendHost->get<std::string>() == "process";
+}
+
+/**
+ * @brief Start the plugin's backend in a worker process.
+ * 
+ * @param {SettingsStore::PluginTypeSchema} plugin - The plugin to start.
+ * @param {std::shared_ptr<PluginExecutor>} executor - Executor of the plugin's proxy interpreter, the worker's API calls run on it.
+ * @returns {bool} - False if the process couldn't be started, always on macOS where there is no worker.
+ */
+MILLENNIUM bool BackendWorkers::Start(const SettingsStore::PluginTypeSchema& plugin, std::shared_ptr<PluginExecutor> executor)
+{
+    #ifdef __APPLE__
+    {
+        LOG_ERROR("'{}' asked for \"backendHost\": \"process\", which isn't supported on macOS", plugin.pluginName);
+        ErrorToLogger(plugin.pluginName, "Running the backend in its own process isn't supported on macOS, remove \"backendHost\": \"process\" from plugin.json.");
+        return false;
+    }
+    #endif
+
+    auto worker = std::make_shared<BackendWorker>(plugin, std::move(executor));
+
+    if (!worker->Start()) 
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_workers[plugin.pluginName] = std::move(worker);
+    return true;
+}
+
+/**
+ * @brief Unload the plugin in its worker process and wait for the process to exit.
+ * @returns {bool} - False if the plugin doesn't run out of process.
+ */
+MILLENNIUM bool BackendWorkers::Stop(const std::string& pluginName)
+{
+    std::shared_ptr<BackendWorker> worker;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_workers.find(pluginName);
+
+        if (it == m_workers.end()) 
+        {
+            return false;
+        }
+
+        worker = std::move(it->second);
+        m_workers.erase(it);
+    }
+
+    worker->Stop();
+    return true;
+}
+
+MILLENNIUM std::shared_ptr<BackendWorker> BackendWorkers::Find(const std::string& pluginName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_workers.find(pluginName);
+
+    return it != m_workers.end() ? it->second : nullptr;
+}
@@ -0,0 +1,283 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * cdp_passthrough.cc
+ *
+ * Routes DevTools protocol events from the browser connection to plugin backends that subscribed to them, see CdpPassthrough.
+ */
+#include "cdp_passthrough.h"
+#include "co_spawn.h"
+#include "ffi.h"
+#include "plugin_logger.h"
+#include "internal_logger.h"
+#include "fvisible.h"
+
+MILLENNIUM CdpPassthrough& CdpPassthrough::get()
+{
+    static CdpPassthrough instance;
+    return instance;
+}
+
+/**
+ * @brief Start delivering `eventMethod` events to `callback`, called with the subscriber's GIL held.
+ * 
+ * @param {std::optional<std::string>} sessionId - Only deliver events of this attached target, events of every target when empty.
+ * @param {PyObject*} callback - Called as callback(params, session_id), a new reference is taken.
+ * @returns {uint64_t} - The subscription id, pass it to Unsubscribe.
+ */
+MILLENNIUM uint64_t CdpPassthrough::Subscribe(std::string pluginName, std::string eventMethod, std::optional<std::string> sessionId, PyObject* callback)
+{
+    auto subscription = std::make_shared<Subscription>();
+    subscription->pluginName  = std::move(pluginName);
+    subscription->eventMethod = std::move(eventMethod);
+    subscription->sessionId   = std::move(sessionId);
+    subscription->callback    = callback;
+    Py_INCREF(callback);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    subscription->id = m_nextSubscriptionId++;
+    m_subscriptions[subscription->eventMethod].push_back(subscription);
+
+    if (!m_backlogs.count(subscription->pluginName)) 
+    {
+        m_backlogs[subscription->pluginName] = std::make_shared<PluginBacklog>();
+    }
+
+    return subscription->id;
+}
+
+/**
+ * @brief Stop delivering events to a subscription, called with the subscriber's GIL held.
+ * Events of the subscription that are still queued on the executor are dropped.
+ * 
+ * @returns {bool} - false if the plugin has no subscription with that id.
+ */
+MILLENNIUM bool CdpPassthrough::Unsubscribe(const std::string& pluginName, uint64_t subscriptionId)
+{
+    std::shared_ptr<Subscription> subscription;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto& [eventMethod, subscriptions] : m_subscriptions) 
+        {
+            auto it = std::find_if(subscriptions.begin(), subscriptions.end(), [&](const auto& entry) 
+            {
+                return entry->id == subscriptionId && entry->pluginName == pluginName;
+            });
+
+            if (it != subscriptions.end()) 
+            {
+                subscription = std::move(*it);
+                subscriptions.erase(it);
+
+                if (subscriptions.empty()) 
+                {
+                    m_subscriptions.erase(eventMethod);
+                }
+                break;
+            }
+        }
+    }
+
+    if (!subscription) 
+    {
+        return false;
+    }
+
+    subscription->active = false;
+    Py_CLEAR(subscription->callback);
+    return true;
+}
+
+/**
+ * @brief Drops every subscription of a plugin. Called with the plugin's GIL held right before its interpreter is ended.
+ */
+MILLENNIUM void CdpPassthrough::RemovePluginSubscriptions(const std::string& pluginName)
+{
+    std::vector<std::shared_ptr<Subscription>> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto it = m_subscriptions.begin(); it != m_subscriptions.end(); ) 
+        {
+            auto& subscriptions = it->second;
+
+            for (auto entry = subscriptions.begin(); entry != subscriptions.end(); ) 
+            {
+                if ((*entry)->pluginName == pluginName) 
+                {
+                    removed.push_back(std::move(*entry));
+                    entry = subscriptions.erase(entry);
+                }
+                else ++entry;
+            }
+
+            it = subscriptions.empty() ? m_subscriptions.erase(it) : std::next(it);
+        }
+
+        m_backlogs.erase(pluginName);
+    }
+
+    for (auto& subscription : removed) 
+    {
+        subscription->active = false;
+        Py_CLEAR(subscription->callback);
+    }
+}
+
+/**
+ * @brief Picks subscribed events out of the browser socket traffic and posts them to the subscribers' executors. 
+ * Runs on the socket thread, so it never waits on a plugin.
+ */
+MILLENNIUM void CdpPassthrough::DispatchSocketMessage(const nlohmann::json& message)
+{
+    /** Command responses carry an id, events never do. */
+    if (message.contains("id") || m_stop.load()) 
+    {
+        return;
+    }
+
+    const auto method = message.find("method");
+
+    if (method == message.end() || !method->is_string()) 
+    {
+        return;
+    }
+
+    std::optional<std::string> sessionId;
+
+    if (message.contains("sessionId") && message["sessionId"].is_string()) 
+    {
+        sessionId = message["sessionId"].get<std::string>();
+    }
+
+    std::vector<PendingEvent> pendingEvents;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto subscriptions = m_subscriptions.find(method->get_ref<const std::string&>());
+
+        if (subscriptions == m_subscriptions.end()) 
+        {
+            return;
+        }
+
+        for (const auto& subscription : subscriptions->second) 
+        {
+            if (subscription->sessionId.has_value() && subscription->sessionId != sessionId) 
+            {
+                continue;
+            }
+            pendingEvents.push_back({ subscription, m_backlogs[subscription->pluginName] });
+        }
+    }
+
+    if (pendingEvents.empty()) 
+    {
+        return;
+    }
+
+    /** Shared by every subscriber, the executors only ever read it. */
+    auto params = std::make_shared<const nlohmann::json>(message.value("params", nlohmann::json::object()));
+
+    for (auto& [subscription, backlog] : pendingEvents) 
+    {
+        if (backlog->queuedEvents.load() >= MAX_QUEUED_EVENTS) 
+        {
+            /** Don't flood the log when a subscriber is stuck, report the first drop and then every thousandth. */
+            if (backlog->droppedEvents++ % 1000 == 0) 
+            {
+                Logger.Warn("[{}] is {} DevTools events behind, dropped {} event(s) so far. Its backend is likely blocking.", subscription->pluginName, MAX_QUEUED_EVENTS, backlog->droppedEvents.load());
+            }
+            continue;
+        }
+
+        std::shared_ptr<PluginExecutor> executor = PythonManager::GetInstance().GetPluginExecutor(subscription->pluginName);
+
+        if (!executor) 
+        {
+            continue;
+        }
+
+        backlog->queuedEvents++;
+
+        const bool posted = executor->Post([this, subscription, backlog, params, sessionId]
+        {
+            backlog->queuedEvents--;
+
+            if (!m_stop.load()) 
+            {
+                this->Deliver(*subscription, *params, sessionId);
+            }
+        });
+
+        if (!posted) 
+        {
+            backlog->queuedEvents--;
+        }
+    }
+}
+
+/**
+ * @brief Calls a subscriber with an event, runs on its executor with its GIL held.
+ */
+MILLENNIUM void CdpPassthrough::Deliver(const Subscription& subscription, const nlohmann::json& params, const std::optional<std::string>& sessionId)
+{
+    /** The subscription may have been dropped while the event was queued, `active` is only cleared with the GIL held. */
+    if (!subscription.active) 
+    {
+        return;
+    }
+
+    PyObject* paramsObject = Python::JsonToPyObject(params);
+    PyObject* sessionIdObject = sessionId.has_value() ? PyUnicode_FromString(sessionId->c_str()) : Py_NewRef(Py_None);
+    PyObject* result = paramsObject && sessionIdObject ? PyObject_CallFunctionObjArgs(subscription.callback, paramsObject, sessionIdObject, NULL) : NULL;
+
+    if (result == NULL) 
+    {
+        const auto [errorMessage, traceback] = Python::ActiveExceptionInformation();
+        ErrorToLogger(subscription.pluginName, fmt::format("DevTools event handler for {} failed: {}\n{}", subscription.eventMethod, errorMessage, traceback));
+    }
+
+    Py_XDECREF(result);
+    Py_XDECREF(sessionIdObject);
+    Py_XDECREF(paramsObject);
+}
+
+/**
+ * @brief Stop delivering events, events that are still queued on executors are dropped when they come up.
+ * Subscriptions are left alone, their callbacks die with their interpreters.
+ */
+MILLENNIUM void CdpPassthrough::Shutdown()
+{
+    m_stop = true;
+}
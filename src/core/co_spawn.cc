@@ -35,6 +35,8 @@
 #include "bind_stdout.h"
 #include "plugin_logger.h"
 #include "co_stub.h"
+#include "cdp_passthrough.h"
+#include "backend_worker.h"
 #include "fvisible.h"
 #include <optional>
 
@@ -49,10 +51,10 @@ MILLENNIUM PyObject* PyInit_Millennium(void)
 {
     static struct PyModuleDef module_def = 
     { 
-        PyModuleDef_HEAD_INIT, "Millennium", NULL, -1, (PyMethodDef*)GetMillenniumModule() 
+        PyModuleDef_HEAD_INIT, "Millennium", NULL, 0, (PyMethodDef*)GetMillenniumModule(), g_statelessModuleSlots
     };
 
-    return PyModule_Create(&module_def);
+    return PyModuleDef_Init(&module_def);
 }
 
 /**
@@ -132,7 +134,9 @@ MILLENNIUM PythonManager::PythonManager() : m_InterpreterThreadSave(nullptr)
     }
 
     PyConfig_SetString(&config, &config.home, std::wstring(pythonPath.begin(), pythonPath.end()).c_str());
-    config.write_bytecode = 0;
+    /** Sub-interpreters inherit this, so every plugin only recompiles sources that changed since they were last cached. */
+    PyConfig_SetString(&config, &config.pycache_prefix, std::wstring(pythonBytecodeCache.begin(), pythonBytecodeCache.end()).c_str());
+    config.write_bytecode = 1;
     config.module_search_paths_set = 1;
 
     PyWideStringList_Append(&config.module_search_paths, std::wstring(pythonPath.begin(),     pythonPath.end()    ).c_str());
@@ -166,7 +170,7 @@ done:
  */
 MILLENNIUM PythonManager::~PythonManager()
 {
-    Logger.Warn("Deconstructing {} plugin(s) and preparing for exit...", this->m_pythonInstances.size());
+    Logger.Warn("Deconstructing {} plugin(s) and preparing for exit...", this->m_pythonInstances.GetAll().size());
     
     this->DestroyAllPythonInstances();
 
@@ -184,6 +188,90 @@ MILLENNIUM PythonManager::~PythonManager()
     Logger.Log("Finished shutdown! Bye bye!");
 }
 
+/**
+ * @brief Gets the current snapshot, without waiting on writers.
+ */
+MILLENNIUM std::shared_ptr<const PythonInstanceRegistry::Snapshot> PythonInstanceRegistry::Load() const
+{
+    return std::atomic_load(&this->m_snapshot);
+}
+
+/**
+ * @brief Adds an instance, replacing any previous instance of the same plugin.
+ * 
+ * @param {std::shared_ptr<PythonThreadState>} instance - The instance to add.
+ * @param {PyInterpreterState*} interpreter - The interpreter the instance runs in, every thread state of it is attributed to the instance.
+ */
+MILLENNIUM void PythonInstanceRegistry::Add(std::shared_ptr<PythonThreadState> instance, PyInterpreterState* interpreter)
+{
+    std::lock_guard<std::mutex> lock(this->m_writeMutex);
+    auto snapshot = std::make_shared<Snapshot>(*this->Load());
+
+    auto previous = snapshot->byName.find(instance->pluginName);
+    if (previous != snapshot->byName.end()) 
+    {
+        const auto replaced = previous->second;
+
+        snapshot->instances.erase(std::remove(snapshot->instances.begin(), snapshot->instances.end(), replaced), snapshot->instances.end());
+        for (auto it = snapshot->byInterpreter.begin(); it != snapshot->byInterpreter.end();) 
+        {
+            it = it->second == replaced ? snapshot->byInterpreter.erase(it) : std::next(it);
+        }
+    }
+
+    snapshot->instances.push_back(instance);
+    snapshot->byName[instance->pluginName] = instance;
+    snapshot->byInterpreter[interpreter] = instance;
+
+    std::atomic_store(&this->m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
+/**
+ * @brief Removes an instance, if it is still registered.
+ */
+MILLENNIUM void PythonInstanceRegistry::Remove(const std::shared_ptr<PythonThreadState>& instance)
+{
+    std::lock_guard<std::mutex> lock(this->m_writeMutex);
+    auto snapshot = std::make_shared<Snapshot>(*this->Load());
+
+    snapshot->instances.erase(std::remove(snapshot->instances.begin(), snapshot->instances.end(), instance), snapshot->instances.end());
+
+    auto byName = snapshot->byName.find(instance->pluginName);
+    if (byName != snapshot->byName.end() && byName->second == instance) 
+    {
+        snapshot->byName.erase(byName);
+    }
+
+    /** The interpreter may already be gone, so its entry is found by value rather than by key. */
+    for (auto it = snapshot->byInterpreter.begin(); it != snapshot->byInterpreter.end();) 
+    {
+        it = it->second == instance ? snapshot->byInterpreter.erase(it) : std::next(it);
+    }
+
+    std::atomic_store(&this->m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
+MILLENNIUM std::shared_ptr<PythonThreadState> PythonInstanceRegistry::FindByName(const std::string& pluginName) const
+{
+    const auto snapshot = this->Load();
+    auto it = snapshot->byName.find(pluginName);
+
+    return it != snapshot->byName.end() ? it->second : nullptr;
+}
+
+MILLENNIUM std::shared_ptr<PythonThreadState> PythonInstanceRegistry::FindByInterpreter(PyInterpreterState* interpreter) const
+{
+    const auto snapshot = this->Load();
+    auto it = snapshot->byInterpreter.find(interpreter);
+
+    return it != snapshot->byInterpreter.end() ? it->second : nullptr;
+}
+
+MILLENNIUM std::vector<std::shared_ptr<PythonThreadState>> PythonInstanceRegistry::GetAll() const
+{
+    return this->Load()->instances;
+}
+
 /**
  * @brief Destroys all Python instances.
  * 
@@ -217,11 +305,16 @@ MILLENNIUM bool PythonManager::DestroyAllPythonInstances()
         }
     });
 
-    for (auto it = this->m_pythonInstances.begin(); it != this->m_pythonInstances.end(); /* No increment */) 
     {
-        auto& [pluginName, threadState, interpMutex] = *(*it);
+        std::lock_guard<std::mutex> backendLock(this->m_backendMutex);
+        this->m_backendPlugins.clear();
+    }
+
+    for (const auto& instance : this->m_pythonInstances.GetAll()) 
+    {
+        auto& [pluginName, threadState, interpMutex] = *instance;
 
-        Logger.Log("Instance state: {}", static_cast<void*>(&(*it)));
+        Logger.Log("Instance state: {}", static_cast<void*>(instance.get()));
         {
             std::lock_guard<std::mutex> lg(interpMutex->mtx); 
             interpMutex->flag.store(true); 
@@ -241,6 +334,7 @@ MILLENNIUM bool PythonManager::DestroyAllPythonInstances()
             Logger.Log("Successfully joined thread");
 
             this->m_threadPool.erase(threadIt);
+            JavaScript::ForgetBackendReady(pluginName);
             CoInitializer::BackendCallbacks::getInstance().BackendUnLoaded({ pluginName }, true);
         }
         else
@@ -248,8 +342,7 @@ MILLENNIUM bool PythonManager::DestroyAllPythonInstances()
             LOG_ERROR("Couldn't find thread for plugin '{}'", pluginName);
         }
 
-        it = this->m_pythonInstances.erase(it);
-        Logger.Log("New iterator position after erase: {}", static_cast<void*>(&(*it)));
+        this->m_pythonInstances.Remove(instance);
     }
 
     timeOutLockThreadRunning.store(false);
@@ -273,17 +366,21 @@ MILLENNIUM bool PythonManager::DestroyPythonInstance(std::string targetPluginNam
 
     std::unique_lock<std::mutex> lock(this->m_pythonMutex);  // Lock for thread safety
 
-    for (auto it = this->m_pythonInstances.begin(); it != this->m_pythonInstances.end(); /* No increment */) 
+    for (const auto& instance : this->m_pythonInstances.GetAll()) 
     {
-        auto& [pluginName, threadState, interpMutex] = *(*it);
+        auto& [pluginName, threadState, interpMutex] = *instance;
 
         if (pluginName != targetPluginName) 
         {
-            ++it;
             continue;
         }
 
-        Logger.Log("Instance state: {}", (void*)&it);
+        {
+            std::lock_guard<std::mutex> backendLock(this->m_backendMutex);
+            this->m_backendPlugins.erase(targetPluginName);
+        }
+
+        Logger.Log("Instance state: {}", static_cast<void*>(instance.get()));
 
         {
             std::lock_guard<std::mutex> lg(interpMutex->mtx); 
@@ -305,6 +402,7 @@ MILLENNIUM bool PythonManager::DestroyPythonInstance(std::string targetPluginNam
 
                 Logger.Log("Successfully joined thread");
                 threadIt = this->m_threadPool.erase(threadIt);  // Safe erase
+                JavaScript::ForgetBackendReady(targetPluginName);
                 CoInitializer::BackendCallbacks::getInstance().BackendUnLoaded({ targetPluginName }, isShuttingDown);
                 break;
             } 
@@ -314,15 +412,66 @@ MILLENNIUM bool PythonManager::DestroyPythonInstance(std::string targetPluginNam
             }
         }
 
-        it = this->m_pythonInstances.erase(it);  // Safe erase        
+        this->m_pythonInstances.Remove(instance);
         successfulShutdown = true;
         break;
     }
 
-    Logger.Log("Length of python instances: {}", this->m_pythonInstances.size());
+    Logger.Log("Length of python instances: {}", this->m_pythonInstances.GetAll().size());
     return successfulShutdown;
 }
 
+/**
+ * @brief Creates the sub-interpreter a plugin's backend runs in, and makes its thread state current.
+ * 
+ * Plugins that set `backendOwnGil` in their plugin.json get an interpreter with its own GIL on Python 3.12+, 
+ * so CPU heavy work in them no longer stalls other plugins. Everything such a plugin imports has to support 
+ * per-interpreter GILs, and it can't use daemon threads or os.fork(). Any other plugin shares the main GIL.
+ * @note Millennium is built against Python 3.11 (see find_package in CMakeLists.txt), so the own GIL path isn't compiled 
+ * into release builds and `backendOwnGil` is left out of plugin-schema.json until a 3.12 build is shipped and tested.
+ * 
+ * @param {SettingsStore::PluginTypeSchema} plugin - The plugin to create the interpreter for.
+ * @param {bool&} ownsGil - Set to whether the interpreter got its own GIL.
+ * 
+ * @returns {PyThreadState*} - The interpreter's initial thread state.
+ */
+static PyThreadState* NewPluginInterpreter(const SettingsStore::PluginTypeSchema& plugin, bool& ownsGil)
+{
+    ownsGil = false;
+
+    if (!plugin.pluginJson.value("backendOwnGil", false)) 
+    {
+        return Py_NewInterpreter();
+    }
+
+#if PY_VERSION_HEX >= 0x030C0000
+    PyInterpreterConfig config = 
+    {
+        .use_main_obmalloc = 0,
+        .allow_fork = 0,
+        .allow_exec = 1,
+        .allow_threads = 1,
+        .allow_daemon_threads = 0,
+        .check_multi_interp_extensions = 1,
+        .gil = PyInterpreterConfig_OWN_GIL,
+    };
+
+    PyThreadState* interpreterState = nullptr;
+    const PyStatus status = Py_NewInterpreterFromConfig(&interpreterState, &config);
+
+    if (!PyStatus_Exception(status)) 
+    {
+        ownsGil = true;
+        return interpreterState;
+    }
+
+    LOG_ERROR("couldn't give '{}' its own GIL, it will share the main GIL. reason: {}", plugin.pluginName, status.err_msg ? status.err_msg : "unknown");
+#else
+    Logger.Warn("'{}' asked for its own GIL, which needs Python 3.12 or newer. It will share the main GIL.", plugin.pluginName);
+#endif
+    return Py_NewInterpreter();
+}
+
 /**
  * @brief Creates a new Python instance for a plugin.
  * 
@@ -338,21 +487,41 @@ MILLENNIUM bool PythonManager::CreatePythonInstance(SettingsStore::PluginTypeSch
     const std::string pluginName = plugin.pluginName;
     std::shared_ptr<InterpreterMutex> interpMutexState = std::make_shared<InterpreterMutex>();
 
+    {
+        std::lock_guard<std::mutex> backendLock(this->m_backendMutex);
+        this->m_backendPlugins.insert(pluginName);
+    }
+
     auto thread = std::thread([this, pluginName, callback, plugin, interpMutexStatePtr = interpMutexState ] 
     {
         PyThreadState* threadStateMain = PyThreadState_New(PyInterpreterState_Main());
         PyEval_RestoreThread(threadStateMain);
 
-        PyThreadState* interpreterState = Py_NewInterpreter();
+        bool ownsGil;
+        PyThreadState* interpreterState = NewPluginInterpreter(plugin, ownsGil);
         PyThreadState_Swap(interpreterState);
         
         std::shared_ptr<PythonThreadState> threadState = std::make_shared<PythonThreadState>(std::string(pluginName), interpreterState, interpMutexStatePtr);
 
-        this->m_pythonInstances.push_back(threadState);
+        auto executor = std::make_shared<PluginExecutor>(pluginName, PyThreadState_GetInterpreter(interpreterState));
+        executor->Start();
+        {
+            std::lock_guard<std::mutex> backendLock(this->m_backendMutex);
+            this->m_executors[pluginName] = executor;
+        }
+
+        this->m_pythonInstances.Add(threadState, PyThreadState_GetInterpreter(interpreterState));
         RedirectOutput();
         callback(plugin);
 
         Logger.Log("Plugin '{}' finished delegating callback function...", pluginName);
+
+        if (ownsGil) 
+        {
+            /** The main GIL was released when the interpreter took its own, go back through the GILs rather than swapping thread states. */
+            PyEval_SaveThread();
+            PyEval_RestoreThread(threadStateMain);
+        }
         
         PyThreadState_Clear(threadStateMain);
         PyThreadState_Swap(threadStateMain);
@@ -365,21 +534,48 @@ MILLENNIUM bool PythonManager::CreatePythonInstance(SettingsStore::PluginTypeSch
         });
 
         Logger.Log("Orphaned '{}', jumping off the mutex lock...", pluginName);
+
+        /** An out of process backend unloads in its worker, which may still call the API on the executor while it does. */
+        const bool wasOutOfProcess = BackendWorkers::get().Stop(pluginName);
+
+        /** Runs whatever was still queued for the plugin, its thread state has to be gone before the interpreter can end. */
+        {
+            std::lock_guard<std::mutex> backendLock(this->m_backendMutex);
+            this->m_executors.erase(pluginName);
+        }
+        executor->Stop();
         
-        std::shared_ptr<PythonGIL> pythonGilLock = std::make_shared<PythonGIL>();
-        pythonGilLock->HoldAndLockGILOnThread(interpreterState);
+        std::shared_ptr<PythonGIL> pythonGilLock;
+
+        if (ownsGil) 
+        {
+            PyEval_RestoreThread(interpreterState);
+        }
+        else 
+        {
+            pythonGilLock = std::make_shared<PythonGIL>();
+            pythonGilLock->HoldAndLockGILOnThread(interpreterState);
+        }
 
-        if (pluginName != "pipx" && PyRun_SimpleString("plugin._unload()") != 0) 
+        if (pluginName != "pipx" && !wasOutOfProcess && PyRun_SimpleString("plugin._unload()") != 0) 
         {
             PyErr_Print();
             Logger.Warn("'{}' refused to shutdown properly, force shutting down plugin...", pluginName);
             ErrorToLogger(pluginName, "Failed to shut down plugin properly, force shutting down plugin...");
         }
 
+        /** Subscription callbacks belong to this interpreter, they have to go before it does. */
+        CdpPassthrough::get().RemovePluginSubscriptions(pluginName);
+
         Logger.Log("Shutting down plugin '{}'", pluginName);
         Py_EndInterpreter(interpreterState);
         Logger.Log("Ended sub-interpreter...", pluginName);
-        pythonGilLock->ReleaseAndUnLockGIL();
+
+        /** An interpreter with its own GIL takes it down with it, there is nothing left to release. */
+        if (pythonGilLock) 
+        {
+            pythonGilLock->ReleaseAndUnLockGIL();
+        }
         Logger.Log("Shut down plugin '{}'", pluginName);
     });
 
@@ -390,46 +586,49 @@ MILLENNIUM bool PythonManager::CreatePythonInstance(SettingsStore::PluginTypeSch
 /**
  * @brief Checks if a plugin is running.
  * 
- * This function iterates through the list of Python instances and returns true if the plugin is running.
- * 
  * @param {std::string} targetPluginName - The name of the plugin to check if it is running.
  * 
  * @returns {bool} - True if the plugin is running, false otherwise.
  */ 
 MILLENNIUM bool PythonManager::IsRunning(std::string targetPluginName)
 {
-    for (auto instance : this->m_pythonInstances) 
-    {
-        const auto& [pluginName, thread_ptr, interpMutex] = *instance;
-
-        if (targetPluginName == pluginName) 
-        {
-            return true;
-        }
-    }
-    return false;
+    return this->m_pythonInstances.FindByName(targetPluginName) != nullptr;
 }
 
+/**
+ * @brief Checks if a plugin has a backend.
+ * 
+ * This is on the hot path of every frontend -> backend call, so it is answered from the in memory 
+ * table maintained by CreatePythonInstance and DestroyPythonInstance rather than from the settings store.
+ * 
+ * @param {std::string} targetPluginName - The name of the plugin to check.
+ * 
+ * @returns {bool} - True if a backend was started for the plugin and hasn't been torn down.
+ */
 MILLENNIUM bool PythonManager::HasBackend(std::string targetPluginName)
 {
-    std::unique_ptr<SettingsStore> settingsStore = std::make_unique<SettingsStore>();
-
-    for (const auto& plugin : settingsStore->GetEnabledBackends()) 
-    {
-        if (plugin.pluginName == targetPluginName) 
-        {
-            return true;
-        }
-    }
-    return false;
+    std::lock_guard<std::mutex> lock(this->m_backendMutex);
+    return this->m_backendPlugins.find(targetPluginName) != this->m_backendPlugins.end();
 }
 
 
 /**
- * @brief Gets the Python thread state from the plugin name.
+ * @brief Gets the executor that runs work on a plugin's backend, see PluginExecutor.
  * 
- * This function iterates through the list of Python instances and returns the thread state
- * associated with the given plugin name.
+ * @param {std::string} pluginName - The name of the plugin.
+ * 
+ * @returns {std::shared_ptr<PluginExecutor>} - The executor, or nullptr if the backend isn't running (anymore).
+ */
+MILLENNIUM std::shared_ptr<PluginExecutor> PythonManager::GetPluginExecutor(const std::string& pluginName)
+{
+    std::lock_guard<std::mutex> lock(this->m_backendMutex);
+
+    auto it = this->m_executors.find(pluginName);
+    return it != this->m_executors.end() ? it->second : nullptr;
+}
+
+/**
+ * @brief Gets the Python thread state from the plugin name.
  * 
  * @param {std::string} targetPluginName - The name of the plugin to get the thread state from.
  * 
@@ -437,23 +636,20 @@ MILLENNIUM bool PythonManager::HasBackend(std::string targetPluginName)
  */
 MILLENNIUM std::optional<std::shared_ptr<PythonThreadState>> PythonManager::GetPythonThreadStateFromName(std::string targetPluginName)
 {
-    for (auto instance : this->m_pythonInstances) 
-    {
-        const auto& [pluginName, thread_ptr, interpMutex] = *instance;
+    auto instance = this->m_pythonInstances.FindByName(targetPluginName);
 
-        if (targetPluginName == pluginName) 
-        {
-            return instance;
-        }
+    if (instance == nullptr) 
+    {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return instance;
 }
 
 /**
  * @brief Gets the plugin name from the thread state.
  * 
- * This function iterates through the list of Python instances and returns the plugin name
- * associated with the given thread state.
+ * Every thread state of a plugin's interpreter (the main one, executor threads and threads the plugin spawned itself) 
+ * is attributed to that plugin. This runs on every sys.stdout write, so it is a single lookup that never blocks.
  * 
  * @param {PyThreadState*} thread - The thread state to get the plugin name from.
  * 
@@ -461,14 +657,11 @@ MILLENNIUM std::optional<std::shared_ptr<PythonThreadState>> PythonManager::GetP
  */
 MILLENNIUM std::string PythonManager::GetPluginNameFromThreadState(PyThreadState* thread) 
 {
-    for (auto instance : this->m_pythonInstances)
+    if (thread == nullptr) 
     {
-        const auto& [pluginName, thread_ptr, interpMutex] = *instance;
-
-        if (thread_ptr != nullptr && thread_ptr == thread) 
-        {
-            return pluginName;
-        }
+        return {};
     }
-    return {};
-}
\ No newline at end of file
+
+    auto instance = this->m_pythonInstances.FindByInterpreter(PyThreadState_GetInterpreter(thread));
+    return instance != nullptr ? instance->pluginName : std::string();
+}
@@ -46,6 +46,7 @@
 #include <env.h>
 #include "fvisible.h"
 #include <secure_socket.h>
+#include "backend_worker.h"
 
 static std::string addedScriptOnNewDocumentId = "";
 
@@ -363,6 +364,8 @@ MILLENNIUM const void SetPluginEnvironmentVariables(PyObject* globalDictionary,
  * 4. Appends the plugin's virtual environment and site-packages directory to `sys.path`.
  * 5. Attempts to open and execute the main module of the plugin. If the file cannot be opened or there is an error during execution, it logs the error and notifies the backend handler.
  * 6. If successful, it calls `StartPluginBackend` to continue the plugin startup process.
+ * 
+ * Plugins whose backend runs out of process (see BackendWorker) only get step 1, and their worker process is started instead.
  *
  * Error Handling:
  * - If any step of the process fails (e.g., file opening, module import), the error is logged and the backend load is marked as failed.
@@ -376,6 +379,19 @@ MILLENNIUM const void CoInitializer::BackendStartCallback(SettingsStore::PluginT
     SetPluginSecretName(globalDictionary, plugin.pluginName);
     SetPluginEnvironmentVariables(globalDictionary, plugin);
 
+    /** The backend runs in its own process, this interpreter only stands in for it when it calls the Millennium API. */
+    if (BackendWorkers::IsOutOfProcess(plugin)) 
+    {
+        Logger.Log("Running plugin out of process: {}", plugin.pluginName);
+
+        if (!BackendWorkers::get().Start(plugin, PythonManager::GetInstance().GetPluginExecutor(plugin.pluginName))) 
+        {
+            ErrorToLogger(plugin.pluginName, "Failed to start the plugin's backend process.");
+            CoInitializer::BackendCallbacks::getInstance().BackendLoaded({ plugin.pluginName, CoInitializer::BackendCallbacks::BACKEND_LOAD_FAILED });
+        }
+        return;
+    }
+
     std::vector<std::filesystem::path> sysPath;
     sysPath.push_back(plugin.pluginBaseDirectory / plugin.backendAbsoluteDirectory.parent_path());
 
@@ -0,0 +1,305 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * frontend_console.cc
+ *
+ * Collects Runtime console and exception events from the SharedJSContext into per plugin rings, see FrontendConsole.
+ */
+#include "frontend_console.h"
+#include "locals.h"
+#include "loader.h"
+#include "url_parser.h"
+#include "fvisible.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+static constexpr const char* FRONTEND_ORIGIN = "https://millennium.ftp/";
+
+MILLENNIUM FrontendConsole& FrontendConsole::get()
+{
+    static FrontendConsole instance;
+    return instance;
+}
+
+MILLENNIUM void FrontendConsole::ConsoleRing::Push(BackendLogger::LogEntry entry)
+{
+    if (entries.empty()) 
+    {
+        entries.resize(MAX_ENTRIES_PER_PLUGIN);
+    }
+
+    entries[head] = std::move(entry);
+    head = (head + 1) % MAX_ENTRIES_PER_PLUGIN;
+    count = std::min(count + 1, MAX_ENTRIES_PER_PLUGIN);
+}
+
+/**
+ * @brief Copy the ring out oldest first.
+ */
+MILLENNIUM std::vector<BackendLogger::LogEntry> FrontendConsole::ConsoleRing::Snapshot() const
+{
+    std::vector<BackendLogger::LogEntry> snapshot;
+    snapshot.reserve(count);
+
+    const size_t oldest = (head + MAX_ENTRIES_PER_PLUGIN - count) % MAX_ENTRIES_PER_PLUGIN;
+
+    for (size_t i = 0; i < count; i++) 
+    {
+        snapshot.push_back(entries[(oldest + i) % MAX_ENTRIES_PER_PLUGIN]);
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Map every plugin to the directories its frontend is served from. Internal plugins serve their 
+ * frontend from the assets folder, so the frontend's own directory is included next to the plugin root.
+ * Called by the loader whenever it re-reads the plugin list, so the socket thread never touches the disk for it.
+ */
+MILLENNIUM void FrontendConsole::SetPlugins(const std::vector<SettingsStore::PluginTypeSchema>& plugins)
+{
+    std::vector<std::pair<std::string, std::string>> pluginDirectories;
+
+    for (const auto& plugin : plugins) 
+    {
+        for (const auto& directory : { plugin.frontendAbsoluteDirectory.parent_path(), plugin.pluginBaseDirectory }) 
+        {
+            std::string prefix = directory.generic_string();
+
+            if (prefix.empty()) 
+            {
+                continue;
+            }
+
+            if (prefix.back() != '/') 
+            {
+                prefix.push_back('/');
+            }
+
+            pluginDirectories.emplace_back(std::move(prefix), plugin.pluginName);
+        }
+    }
+
+    /** Most specific directory wins when plugins are nested in each other. */
+    std::sort(pluginDirectories.begin(), pluginDirectories.end(), [](const auto& a, const auto& b) { return a.first.size() > b.first.size(); });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pluginDirectories = std::move(pluginDirectories);
+}
+
+/**
+ * @brief Find the plugin a script URL belongs to.
+ * @returns {std::string} - The plugin name, or an empty string for anything that isn't served from a plugin.
+ */
+MILLENNIUM std::string FrontendConsole::AttributeUrl(const std::string& url)
+{
+    if (url.compare(0, std::char_traits<char>::length(FRONTEND_ORIGIN), FRONTEND_ORIGIN) != 0) 
+    {
+        return {};
+    }
+
+    std::string path = url.substr(std::char_traits<char>::length(FRONTEND_ORIGIN));
+    path = PathFromUrl(path.substr(0, path.find_first_of("?#")));
+
+    for (const auto& [prefix, pluginName] : m_pluginDirectories) 
+    {
+        if (path.compare(0, prefix.size(), prefix) == 0) 
+        {
+            return pluginName;
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Attribute an event to the innermost plugin frame on its stack. The top frame often belongs to Steam 
+ * when a plugin calls into its libraries, so every frame is checked in order.
+ */
+MILLENNIUM std::string FrontendConsole::AttributeStackTrace(const nlohmann::json& stackTrace)
+{
+    if (!stackTrace.is_object() || !stackTrace.contains("callFrames") || !stackTrace["callFrames"].is_array()) 
+    {
+        return {};
+    }
+
+    for (const auto& frame : stackTrace["callFrames"]) 
+    {
+        std::string pluginName = this->AttributeUrl(frame.value("url", std::string()));
+
+        if (!pluginName.empty()) 
+        {
+            return pluginName;
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Render a Runtime.RemoteObject the way the console would, without fetching any properties.
+ */
+static std::string RemoteObjectToString(const nlohmann::json& remoteObject)
+{
+    if (remoteObject.contains("value")) 
+    {
+        const auto& value = remoteObject["value"];
+        return value.is_string() ? value.get<std::string>() : value.dump();
+    }
+
+    if (remoteObject.contains("unserializableValue")) 
+    {
+        return remoteObject["unserializableValue"].get<std::string>();
+    }
+
+    return remoteObject.value("description", remoteObject.value("type", std::string("undefined")));
+}
+
+static BackendLogger::LogLevel ConsoleTypeToLevel(const std::string& type)
+{
+    if (type == "error" || type == "assert") return BackendLogger::_ERROR;
+    if (type == "warning")                   return BackendLogger::_WARN;
+
+    return BackendLogger::_INFO;
+}
+
+/**
+ * @brief Picks console events out of the browser socket traffic. Runs on the socket thread.
+ */
+MILLENNIUM void FrontendConsole::DispatchSocketMessage(const nlohmann::json& message)
+{
+    const std::string method = message.value("method", std::string());
+
+    if (method != "Runtime.consoleAPICalled" && method != "Runtime.exceptionThrown") 
+    {
+        return;
+    }
+
+    /** Other targets attached through the DevTools passthrough report their console too, only the SharedJSContext runs plugin frontends. */
+    if (!Sockets::IsSharedJsContextMessage(message)) 
+    {
+        return;
+    }
+
+    const auto& params = message["params"];
+    std::string pluginName;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (method == "Runtime.consoleAPICalled") 
+        {
+            pluginName = this->AttributeStackTrace(params.value("stackTrace", nlohmann::json()));
+        }
+        else 
+        {
+            const auto details = params.value("exceptionDetails", nlohmann::json::object());
+            pluginName = this->AttributeStackTrace(details.value("stackTrace", nlohmann::json()));
+
+            if (pluginName.empty()) 
+            {
+                pluginName = this->AttributeUrl(details.value("url", std::string()));
+            }
+        }
+    }
+
+    if (pluginName.empty()) 
+    {
+        return;
+    }
+
+    if (method == "Runtime.consoleAPICalled") 
+    {
+        std::string text;
+
+        for (const auto& argument : params.value("args", nlohmann::json::array())) 
+        {
+            if (!text.empty()) text.push_back(' ');
+            text.append(RemoteObjectToString(argument));
+        }
+
+        const std::string type = params.value("type", std::string("log"));
+        this->Record(pluginName, std::move(text), ConsoleTypeToLevel(type));
+    }
+    else 
+    {
+        const auto& details = params["exceptionDetails"];
+        std::string text = details.contains("exception") ? RemoteObjectToString(details["exception"]) : details.value("text", std::string("Uncaught exception"));
+
+        this->Record(pluginName, std::move(text), BackendLogger::_ERROR);
+    }
+}
+
+MILLENNIUM void FrontendConsole::Record(const std::string& pluginName, std::string message, BackendLogger::LogLevel level)
+{
+    if (message.size() > MAX_MESSAGE_LENGTH) 
+    {
+        message.resize(MAX_MESSAGE_LENGTH);
+        message.append("...");
+    }
+
+    std::stringstream timeStream;
+    const auto now = std::chrono::system_clock::now();
+    const auto time = std::chrono::system_clock::to_time_t(now);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+
+    timeStream << std::put_time(std::localtime(&time), "%H:%M:%S") << fmt::format(".{:03}", ms.count());
+
+    const char* color = level == BackendLogger::_ERROR ? RED : level == BackendLogger::_WARN ? YELLOW : RESET;
+    std::string formatted = fmt::format("{}[{}]{} {}[frontend]{} {}{}{}\n", WHITE, timeStream.str(), RESET, MAGENTA, RESET, color, message, RESET);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rings[pluginName].Push({ std::move(formatted), level });
+}
+
+/**
+ * @brief Get the captured frontend entries of a plugin, oldest first.
+ */
+MILLENNIUM std::vector<BackendLogger::LogEntry> FrontendConsole::CollectLogs(const std::string& pluginName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto ring = m_rings.find(pluginName);
+
+    return ring == m_rings.end() ? std::vector<BackendLogger::LogEntry>() : ring->second.Snapshot();
+}
+
+/**
+ * @brief Get every plugin that has captured frontend entries.
+ */
+MILLENNIUM std::vector<std::string> FrontendConsole::GetPluginNames()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> pluginNames;
+
+    for (const auto& [pluginName, ring] : m_rings) 
+    {
+        pluginNames.push_back(pluginName);
+    }
+    return pluginNames;
+}
@@ -0,0 +1,281 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hook_profiler.h"
+#include "fvisible.h"
+#include <algorithm>
+
+/**
+ * Groups requests by kind and origin, i.e "document https://store.steampowered.com".
+ * Paths and queries are dropped so that histograms don't grow with every unique URL.
+ */
+static std::string GetUrlPattern(const std::string& url, const char* kind)
+{
+    const size_t schemeEnd = url.find("://");
+    const size_t originEnd = schemeEnd == std::string::npos ? std::string::npos : url.find('/', schemeEnd + 3);
+
+    return std::string(kind) + " " + url.substr(0, originEnd);
+}
+
+static unsigned long long ToMicros(std::chrono::steady_clock::duration duration)
+{
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+MILLENNIUM void HookProfiler::Histogram::Add(unsigned long long micros)
+{
+    size_t bucket = 0;
+    while (bucket < m_bucketCount - 1 && micros > (1ULL << bucket)) 
+    {
+        bucket++;
+    }
+
+    buckets[bucket]++;
+    count++;
+    totalMicros += micros;
+    maxMicros = std::max(maxMicros, micros);
+}
+
+MILLENNIUM HookProfiler::HookProfiler() : m_epoch(Clock::now())
+{ }
+
+MILLENNIUM HookProfiler& HookProfiler::get()
+{
+    static HookProfiler instance;
+    return instance;
+}
+
+/**
+ * @brief Turn recording on or off. Requests in flight are forgotten when it is turned off, collected histograms and traces are kept.
+ */
+MILLENNIUM void HookProfiler::SetEnabled(bool isEnabled)
+{
+    std::lock_guard<std::mutex> lock(m_profilerMutex);
+    m_isEnabled.store(isEnabled, std::memory_order_relaxed);
+
+    if (!isEnabled) 
+    {
+        m_inFlight.clear();
+    }
+}
+
+MILLENNIUM bool HookProfiler::IsEnabled() const
+{
+    return m_isEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Drop the oldest quarter of the requests in flight, by start time.
+ * Requests that never completed (i.e the page was closed mid request) are the oldest, so requests still being handled keep their waterfall.
+ */
+MILLENNIUM void HookProfiler::EvictOldestInFlight()
+{
+    std::vector<std::unordered_map<std::string, RequestTrace>::iterator> requests;
+    requests.reserve(m_inFlight.size());
+
+    for (auto request = m_inFlight.begin(); request != m_inFlight.end(); ++request) 
+    {
+        requests.push_back(request);
+    }
+
+    const size_t evictCount = std::max<size_t>(1, requests.size() / 4);
+    std::nth_element(requests.begin(), requests.begin() + (evictCount - 1), requests.end(), [](const auto& a, const auto& b) {
+        return a->second.start < b->second.start;
+    });
+
+    for (size_t i = 0; i < evictCount; i++) 
+    {
+        m_inFlight.erase(requests[i]);
+    }
+}
+
+/**
+ * @brief Start a waterfall for a paused request.
+ */
+MILLENNIUM void HookProfiler::Begin(const std::string& requestId, const std::string& url, const char* kind)
+{
+    if (!this->IsEnabled()) 
+    {
+        return;
+    }
+
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_profilerMutex);
+
+    if (m_inFlight.size() >= m_maxInFlight) 
+    {
+        this->EvictOldestInFlight();
+    }
+
+    m_inFlight[requestId] = { url, GetUrlPattern(url, kind), now, {}, m_sequence++ };
+}
+
+/**
+ * @brief Mark the end of a stage, the stage spans from the previous mark (or the start of the request) until now.
+ */
+MILLENNIUM void HookProfiler::Mark(const std::string& requestId, const char* stage)
+{
+    if (!this->IsEnabled()) 
+    {
+        return;
+    }
+
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_profilerMutex);
+
+    auto request = m_inFlight.find(requestId);
+    if (request != m_inFlight.end()) 
+    {
+        request->second.marks.push_back({ stage, now });
+    }
+}
+
+/**
+ * @brief Close a fulfilled request, folding its stages into the histograms of its URL pattern.
+ */
+MILLENNIUM void HookProfiler::End(const std::string& requestId)
+{
+    if (!this->IsEnabled()) 
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_profilerMutex);
+
+    auto request = m_inFlight.find(requestId);
+    if (request == m_inFlight.end()) 
+    {
+        return;
+    }
+
+    RequestTrace& trace = request->second;
+    auto& patternHistograms = m_histograms[trace.pattern];
+    Clock::time_point stageStart = trace.start;
+
+    for (const auto& mark : trace.marks) 
+    {
+        patternHistograms[mark.stage].Add(ToMicros(mark.time - stageStart));
+        stageStart = mark.time;
+    }
+    patternHistograms["total"].Add(ToMicros(stageStart - trace.start));
+
+    m_recentTraces.push_back(std::move(trace));
+    if (m_recentTraces.size() > m_maxRecentTraces) 
+    {
+        m_recentTraces.pop_front();
+    }
+
+    m_inFlight.erase(request);
+}
+
+/**
+ * @brief Forget a request that was handed back to Chromium without being fulfilled (redirects, do-not-hook urls...)
+ */
+MILLENNIUM void HookProfiler::Discard(const std::string& requestId)
+{
+    if (!this->IsEnabled()) 
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_profilerMutex);
+    m_inFlight.erase(requestId);
+}
+
+/**
+ * @brief Get the per pattern, per stage histograms.
+ * 
+ * @returns { "<kind> <origin>": { "<stage>": { count, mean_us, max_us, buckets: [{ le_us, count }] } } }
+ * Empty buckets are omitted, the last bucket's `le_us` is null as it's unbounded.
+ */
+MILLENNIUM nlohmann::json HookProfiler::GetHistograms() const
+{
+    std::lock_guard<std::mutex> lock(m_profilerMutex);
+    nlohmann::json result = nlohmann::json::object();
+
+    for (const auto& [pattern, stages] : m_histograms) 
+    {
+        for (const auto& [stage, histogram] : stages) 
+        {
+            nlohmann::json buckets = nlohmann::json::array();
+
+            for (size_t i = 0; i < m_bucketCount; i++) 
+            {
+                if (histogram.buckets[i] == 0) 
+                    continue;
+
+                buckets.push_back({
+                    { "le_us", i == m_bucketCount - 1 ? nlohmann::json(nullptr) : nlohmann::json(1ULL << i) },
+                    { "count", histogram.buckets[i] }
+                });
+            }
+
+            result[pattern][stage] = {
+                { "count",   histogram.count },
+                { "mean_us", histogram.count ? histogram.totalMicros / histogram.count : 0 },
+                { "max_us",  histogram.maxMicros },
+                { "buckets", buckets }
+            };
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Get the recent request waterfalls in the Trace Event Format, loadable by chrome://tracing or Perfetto.
+ * Every request is drawn on its own track, with one complete ("X") event per stage.
+ */
+MILLENNIUM nlohmann::json HookProfiler::GetChromeTrace() const
+{
+    std::lock_guard<std::mutex> lock(m_profilerMutex);
+    nlohmann::json traceEvents = nlohmann::json::array();
+
+    for (const auto& trace : m_recentTraces) 
+    {
+        Clock::time_point stageStart = trace.start;
+
+        traceEvents.push_back({
+            { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", trace.sequence },
+            { "args", { { "name", trace.url } } }
+        });
+
+        for (const auto& mark : trace.marks) 
+        {
+            traceEvents.push_back({
+                { "name", mark.stage }, { "cat", trace.pattern }, { "ph", "X" }, { "pid", 1 }, { "tid", trace.sequence },
+                { "ts", ToMicros(stageStart - m_epoch) }, { "dur", ToMicros(mark.time - stageStart) },
+                { "args", { { "url", trace.url } } }
+            });
+            stageStart = mark.time;
+        }
+    }
+
+    return { { "traceEvents", traceEvents }, { "displayTimeUnit", "ms" } };
+}
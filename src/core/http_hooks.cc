@@ -34,13 +34,15 @@
 #include "ffi.h"
 #include "encoding.h"
 #include "http.h"
+#include <algorithm>
 #include <unordered_set>
-#include "csp_bypass.h"
 #include "url_parser.h"
 #include "env.h"
 #include "fvisible.h"
 #include <secure_socket.h>
 #include "ipc.h"
+#include "hook_profiler.h"
+#include "target_tracker.h"
 #include <thread>
 #include <chrono>
 
@@ -176,9 +178,17 @@ void HttpHookManager::AddHook(const HookType& hook)
 bool HttpHookManager::RemoveHook(unsigned long long moduleId)
 {
     std::unique_lock<std::shared_mutex> lock(m_hookListMutex);
-    
+
+    /** Rewrite rules share the module id space with hooks, so they're removed the same way. */
+    const size_t originalRuleCount = m_rewriteRules.size();
+
+    m_rewriteRules.erase(std::remove_if(m_rewriteRules.begin(), m_rewriteRules.end(),
+        [moduleId](const RewriteRule& rule) {
+            return rule.id == moduleId;
+        }), m_rewriteRules.end());
+
     if (!m_hookListPtr) {
-        return false; // Nothing to remove
+        return m_rewriteRules.size() < originalRuleCount;
     }
     
     size_t originalSize = m_hookListPtr->size();
@@ -190,7 +200,19 @@ bool HttpHookManager::RemoveHook(unsigned long long moduleId)
     
     m_hookListPtr->erase(newEnd, m_hookListPtr->end());
     
-    return m_hookListPtr->size() < originalSize; // Return true if something was removed
+    return m_hookListPtr->size() < originalSize || m_rewriteRules.size() < originalRuleCount; // Return true if something was removed
+}
+
+void HttpHookManager::AddRewriteRule(const RewriteRule& rule)
+{
+    std::unique_lock<std::shared_mutex> lock(m_hookListMutex);
+    m_rewriteRules.push_back(rule);
+}
+
+std::vector<HttpHookManager::RewriteRule> HttpHookManager::GetRewriteRulesCopy() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_hookListMutex);
+    return m_rewriteRules;
 }
 
 // Thread-safe request management
@@ -286,6 +308,7 @@ std::filesystem::path HttpHookManager::ConvertToLoopBack(const std::string& requ
 void HttpHookManager::RetrieveRequestFromDisk(const nlohmann::basic_json<>& message)
 {
     std::string fileContent;
+    const std::string requestId = message.value("/params/requestId"_json_pointer, std::string{});
     std::filesystem::path localFilePath = this->ConvertToLoopBack(message["params"]["request"]["url"]);
     std::ifstream localFileStream(localFilePath);
 
@@ -303,7 +326,9 @@ void HttpHookManager::RetrieveRequestFromDisk(const nlohmann::basic_json<>& mess
     {
         try
         {
-            fileContent = Base64Encode(SystemIO::ReadFileBytesSync(localFilePath.string()));
+            const auto fileBytes = SystemIO::ReadFileBytesSync(localFilePath.string());
+            HookProfiler::get().Mark(requestId, "read");
+            fileContent = Base64Encode(fileBytes);
         }
         catch(const std::exception& error)
         {
@@ -313,11 +338,14 @@ void HttpHookManager::RetrieveRequestFromDisk(const nlohmann::basic_json<>& mess
     } 
     else 
     {
-        fileContent = Base64Encode(std::string(
+        const std::string fileText = std::string(
             std::istreambuf_iterator<char>(localFileStream),
             std::istreambuf_iterator<char>()
-        ));
+        );
+        HookProfiler::get().Mark(requestId, "read");
+        fileContent = Base64Encode(fileText);
     }
+    HookProfiler::get().Mark(requestId, "base64Encode");
 
     const auto responseHeaders = nlohmann::json::array
     ({
@@ -336,6 +364,9 @@ void HttpHookManager::RetrieveRequestFromDisk(const nlohmann::basic_json<>& mess
             { "body", fileContent }
         }}
     });
+
+    HookProfiler::get().Mark(requestId, "fulfill");
+    HookProfiler::get().End(requestId);
 }
 
 void HttpHookManager::GetResponseBody(const nlohmann::basic_json<>& message)
@@ -348,6 +379,7 @@ void HttpHookManager::GetResponseBody(const nlohmann::basic_json<>& message)
             { "method", "Fetch.continueRequest" },
             { "params", { { "requestId", message["params"]["requestId"] } }}
         });
+        HookProfiler::get().Discard(message.value("/params/requestId"_json_pointer, std::string{}));
     };
 
     // Check if the request URL is a do-not-hook URL.
@@ -359,6 +391,7 @@ void HttpHookManager::GetResponseBody(const nlohmann::basic_json<>& message)
             return;
         }
     }
+    HookProfiler::get().Mark(message.value("/params/requestId"_json_pointer, std::string{}), "filter");
 
     // If the status code is a redirect, we just continue the request. 
     if (statusCode == REDIRECT || statusCode == MOVED_PERMANENTLY || statusCode == FOUND || 
@@ -387,7 +420,117 @@ void HttpHookManager::GetResponseBody(const nlohmann::basic_json<>& message)
     }
 }
 
-const std::string HttpHookManager::PatchDocumentContents(const std::string& requestUrl, const std::string& original) 
+/**
+ * Case-insensitive substring search, used to detect closing tags that would break an inlined block.
+ */
+static bool ContainsNoCase(const std::string& haystack, const std::string& needle)
+{
+    return std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    }) != haystack.end();
+}
+
+/**
+ * Builds the shim fragment for a hooked asset that is small enough to be embedded directly into the document.
+ * This saves the paused Fetch round trip a <link> or import() would otherwise cost for tiny files.
+ *
+ * @param {std::string} path - The absolute path of the hooked asset on disk.
+ * @param {TagTypes} type - Whether the asset is a stylesheet or a JavaScript module.
+ * @returns {std::optional<std::string>} - A <style> block for stylesheets, a data: module URL for scripts,
+ *          or std::nullopt if the asset should be served from the virtual FTP address as usual.
+ *
+ * Only assets that don't reference other files are inlined, as relative references would otherwise resolve
+ * against the document (stylesheets) or fail to resolve at all (data: modules) instead of the asset's own path.
+ *
+ * Results are cached per file and invalidated whenever the file size or last write time changes.
+ */
+std::optional<std::string> HttpHookManager::GetInlineAsset(const std::string& path, TagTypes type)
+{
+    std::error_code errorCode;
+    const std::filesystem::path assetPath(path);
+
+    const std::uintmax_t fileSize = std::filesystem::file_size(assetPath, errorCode);
+    if (errorCode || fileSize > m_inlineAssetThreshold) 
+    {
+        return std::nullopt;
+    }
+
+    const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(assetPath, errorCode);
+    if (errorCode) 
+    {
+        return std::nullopt;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_inlineAssetMutex);
+        auto cachedItem = m_inlineAssetCache.find(path);
+
+        if (cachedItem != m_inlineAssetCache.end() && cachedItem->second.fileSize == fileSize && cachedItem->second.lastWriteTime == lastWriteTime) 
+        {
+            return cachedItem->second.fragment;
+        }
+    }
+
+    std::ifstream assetStream(assetPath, std::ios::binary);
+    if (!assetStream.is_open()) 
+    {
+        return std::nullopt;
+    }
+
+    const std::string assetContent((std::istreambuf_iterator<char>(assetStream)), std::istreambuf_iterator<char>());
+    std::optional<std::string> fragment;
+
+    if (type == TagTypes::STYLESHEET) 
+    {
+        // A literal closing tag would end the <style> block early, and url() and @import would resolve against the document.
+        if (!ContainsNoCase(assetContent, "</style") && !ContainsNoCase(assetContent, "url(") && !ContainsNoCase(assetContent, "@import")) 
+        {
+            fragment = fmt::format("<style data-millennium-src=\"{}\">{}</style>\n", UrlFromPath(m_ftpHookAddress, path), assetContent);
+        }
+    }
+    else if (type == TagTypes::JAVASCRIPT) 
+    {
+        // data: modules have no base URL to resolve relative specifiers against, so modules that import or re-export stay on disk.
+        static const std::regex fromSpecifier(R"(\bfrom\s*["'`])");
+
+        if (assetContent.find("import") == std::string::npos && !std::regex_search(assetContent, fromSpecifier)) 
+        {
+            fragment = fmt::format("data:text/javascript;base64,{}", Base64Encode(assetContent));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_inlineAssetMutex);
+    m_inlineAssetCache[path] = { fileSize, lastWriteTime, fragment };
+    return fragment;
+}
+
+/**
+ * Inlined assets are subject to the document's Content Security Policy, a <style> block needs 'unsafe-inline' in
+ * style-src and a data: module needs data: in script-src. Assets are only inlined into documents without a policy,
+ * or into targets Millennium has already bypassed the policy on.
+ *
+ * @param {json} response - The paused Fetch.requestPaused event of the document.
+ * @param {std::string} document - The decoded document body, checked for a <meta> policy.
+ */
+bool HttpHookManager::CanInlineAssets(const nlohmann::basic_json<>& response, const std::string& document)
+{
+    if (TargetTracker::get().IsCspBypassed(response.value(json::json_pointer("/params/frameId"), std::string{}))) 
+    {
+        return true;
+    }
+
+    for (const auto& header : response.value(json::json_pointer("/params/responseHeaders"), nlohmann::json::array())) 
+    {
+        if (ContainsNoCase(header.value("name", std::string{}), "content-security-policy")) 
+        {
+            return false;
+        }
+    }
+
+    return !ContainsNoCase(document, "content-security-policy");
+}
+
+const std::string HttpHookManager::PatchDocumentContents(const std::string& requestUrl, const std::string& original, const std::string& requestId, bool canInlineAssets) 
 {
     std::string patched = original;
     std::optional<std::string> millenniumPreloadPath = SystemIO::GetMillenniumPreloadPath();
@@ -415,6 +558,12 @@ const std::string HttpHookManager::PatchDocumentContents(const std::string& requ
             if (!std::regex_match(requestUrl, hookItem.urlPattern)) 
                 continue;
 
+            if (const auto inlineStyle = canInlineAssets ? this->GetInlineAsset(hookItem.path, hookItem.type) : std::nullopt) 
+            {
+                cssShimContent.append(inlineStyle.value());
+                continue;
+            }
+
             cssShimContent.append(fmt::format("<link rel=\"stylesheet\" href=\"{}\">\n", UrlFromPath(m_ftpHookAddress, hookItem.path))); 
         }
         else if (hookItem.type == TagTypes::JAVASCRIPT) 
@@ -422,6 +571,12 @@ const std::string HttpHookManager::PatchDocumentContents(const std::string& requ
             if (!std::regex_match(requestUrl, hookItem.urlPattern)) 
                 continue;
 
+            if (const auto inlineModule = canInlineAssets ? this->GetInlineAsset(hookItem.path, hookItem.type) : std::nullopt) 
+            {
+                scriptModules.push_back(inlineModule.value());
+                continue;
+            }
+
             auto jsPath = UrlFromPath(this->m_ftpHookAddress, hookItem.path);
             scriptModules.push_back(jsPath);
             linkPreloadsArray.append(fmt::format("<link rel=\"modulepreload\" href=\"{}\" fetchpriority=\"high\">\n", jsPath));
@@ -442,20 +597,101 @@ const std::string HttpHookManager::PatchDocumentContents(const std::string& requ
     std::string importScript = fmt::format("import('{}').then(module => {{ {} }}).catch(error => window.location.reload())", ftpPath, scriptContent);
     std::string shimContent = fmt::format("{}<script type=\"module\" async id=\"millennium-injected\">{}</script>\n{}", linkPreloadsArray, importScript, cssShimContent);
 
+    bool isBlackListedUrl = false;
+
     for (const auto& blackListedUrl : g_blackListedUrls)        
     {
         if (std::regex_match(requestUrl, std::regex(blackListedUrl))) 
         {
             shimContent = cssShimContent; // Remove all queried JavaScript from the page. 
+            isBlackListedUrl = true;
+        }
+    }
+    HookProfiler::get().Mark(requestId, "match");
+
+    /** Every change to the document is collected first, then the patched document is assembled in a single pass. */
+    struct DocumentEdit {
+        size_t position;
+        size_t length;
+        const std::string* content;
+
+        /** Whether the two can't both be applied, i.e a replacement covers text the other replaces or is inserted into. */
+        bool Overlaps(const DocumentEdit& other) const {
+            return position < other.position + other.length && other.position < position + length;
         }
+    };
+    std::vector<DocumentEdit> documentEdits;
+
+    /** The shim is always applied, it goes first so rule edits are checked against it like against any earlier rule. */
+    const size_t headPosition = original.find("<head>");
+    if (headPosition != std::string::npos) 
+    {
+        documentEdits.push_back({ headPosition + 6, 0, &shimContent });
     }
 
-    if (patched.find("<head>") == std::string::npos) 
+    /** Rewrite rules may insert arbitrary markup, so they are never applied to pages JavaScript is blocked on. */
+    const auto rewriteRules = isBlackListedUrl ? std::vector<RewriteRule>() : GetRewriteRulesCopy();
+
+    for (const auto& rule : rewriteRules) 
     {
+        if (rule.match.empty() || !std::regex_match(requestUrl, rule.urlPattern)) 
+            continue;
+
+        for (size_t position = original.find(rule.match); position != std::string::npos; position = original.find(rule.match, position + rule.match.size())) 
+        {
+            DocumentEdit ruleEdit;
+
+            switch (rule.action) 
+            {
+                case RewriteAction::REPLACE:       { ruleEdit = { position, rule.match.size(), &rule.content };    break; }
+                case RewriteAction::INSERT_BEFORE: { ruleEdit = { position, 0, &rule.content };                    break; }
+                case RewriteAction::INSERT_AFTER:  { ruleEdit = { position + rule.match.size(), 0, &rule.content }; break; }
+            }
+
+            /** Overlapping edits are resolved in the order they were registered, the earlier one wins. */
+            const bool overlapsEarlierEdit = std::any_of(documentEdits.begin(), documentEdits.end(), [&ruleEdit](const DocumentEdit& edit) { return edit.Overlaps(ruleEdit); });
+
+            if (overlapsEarlierEdit) 
+            {
+                Logger.Warn("Skipped a rewrite rule of '{}' on {}, it overlaps an earlier edit of the page.", rule.match, requestUrl);
+                continue;
+            }
+            documentEdits.push_back(ruleEdit);
+        }
+    }
+
+    if (documentEdits.empty()) 
+    {
+        HookProfiler::get().Mark(requestId, "patch");
         return patched;
     }
 
-    return patched.replace(patched.find("<head>"), 6, "<head>" + shimContent);
+    /** Insertions at the same position keep the order they were registered in, and go before a replacement starting there. */
+    std::stable_sort(documentEdits.begin(), documentEdits.end(), [](const DocumentEdit& a, const DocumentEdit& b) 
+    { 
+        return a.position < b.position || (a.position == b.position && a.length == 0 && b.length != 0); 
+    });
+
+    size_t patchedSize = original.size();
+    for (const auto& edit : documentEdits) 
+    {
+        patchedSize += edit.content->size();
+    }
+
+    patched.clear();
+    patched.reserve(patchedSize);
+    size_t cursor = 0;
+
+    for (const auto& edit : documentEdits) 
+    {
+        patched.append(original, cursor, edit.position - cursor);
+        patched.append(*edit.content);
+        cursor = edit.position + edit.length;
+    }
+
+    patched.append(original, cursor, std::string::npos);
+    HookProfiler::get().Mark(requestId, "patch");
+    return patched;
 }
 
 void HttpHookManager::HandleHooks(const nlohmann::basic_json<>& message)
@@ -476,12 +712,19 @@ void HttpHookManager::HandleHooks(const nlohmann::basic_json<>& message)
             std::string requestUrl = response.value(json::json_pointer("/params/request/url"), std::string{});
             std::string responseBody = message.value(json::json_pointer("/result/body"), std::string{});
            
+            HookProfiler::get().Mark(requestId, "getResponseBody");
+
             if (requestUrl.empty() || responseBody.empty()) {
+                HookProfiler::get().Discard(requestId);
                 return true; 
             }
            
-            const std::string patchedContent = this->PatchDocumentContents(requestUrl, Base64Decode(responseBody));
-            BypassCSP();
+            const std::string decodedContent = Base64Decode(responseBody);
+            HookProfiler::get().Mark(requestId, "base64Decode");
+
+            const std::string patchedContent = this->PatchDocumentContents(requestUrl, decodedContent, requestId, this->CanInlineAssets(response, decodedContent));
+            const std::string encodedContent = Base64Encode(patchedContent);
+            HookProfiler::get().Mark(requestId, "base64Encode");
            
             const int responseCode = response.value(json::json_pointer("/params/responseStatusCode"), 200);
             const std::string responseMessage = response.value(json::json_pointer("/params/responseStatusText"), std::string{"OK"});
@@ -495,9 +738,12 @@ void HttpHookManager::HandleHooks(const nlohmann::basic_json<>& message)
                     { "responseCode", responseCode },
                     { "responseHeaders", responseHeaders },
                     { "responsePhrase", responseMessage.empty() ? "OK" : responseMessage },
-                    { "body", Base64Encode(patchedContent) }
+                    { "body", encodedContent }
                 }}
             });
+
+            HookProfiler::get().Mark(requestId, "fulfill");
+            HookProfiler::get().End(requestId);
             return true;
         }
         catch (const nlohmann::detail::exception& ex)
@@ -515,6 +761,9 @@ void HttpHookManager::HandleHooks(const nlohmann::basic_json<>& message)
 
 void HttpHookManager::HandleIpcMessage(nlohmann::json message)
 {
+    const std::string requestId = message.value("/params/requestId"_json_pointer, std::string{});
+    HookProfiler::get().Mark(requestId, "queue");
+
     nlohmann::json responseJson = {
         { "id", 63453 },
         { "method", "Fetch.fulfillRequest" },
@@ -536,6 +785,7 @@ void HttpHookManager::HandleIpcMessage(nlohmann::json message)
     if (message.value(json::json_pointer("/params/request/method"), std::string{}) == "OPTIONS")
     {
         this->PostGlobalMessage(responseJson);
+        HookProfiler::get().Discard(requestId);
         return;
     }
 
@@ -545,6 +795,7 @@ void HttpHookManager::HandleIpcMessage(nlohmann::json message)
         LOG_ERROR("Invalid or missing X-Millennium-Auth in IPC request.");
         responseJson["params"]["responseCode"] = 401; // Unauthorized
         this->PostGlobalMessage(responseJson);
+        HookProfiler::get().Discard(requestId);
         return;
     }
 
@@ -572,11 +823,15 @@ void HttpHookManager::HandleIpcMessage(nlohmann::json message)
         LOG_ERROR("IPC request with no post data, this is not allowed.");
         responseJson["params"]["responseCode"] = 400;
         this->PostGlobalMessage(responseJson);
+        HookProfiler::get().Discard(requestId);
         return;
     }
     
     const auto result = IPCMain::HandleEventMessage(postData);
+    HookProfiler::get().Mark(requestId, "ipc");
+
     responseJson["params"]["body"] = Base64Encode(result.dump());
+    HookProfiler::get().Mark(requestId, "base64Encode");
 
     if (result.contains("error"))
     {
@@ -593,6 +848,8 @@ void HttpHookManager::HandleIpcMessage(nlohmann::json message)
     }
 
     this->PostGlobalMessage(responseJson);
+    HookProfiler::get().Mark(requestId, "fulfill");
+    HookProfiler::get().End(requestId);
 }
 
 void HttpHookManager::DispatchSocketMessage(nlohmann::basic_json<> message)
@@ -601,7 +858,15 @@ void HttpHookManager::DispatchSocketMessage(nlohmann::basic_json<> message)
     {
         if (message["method"] == "Fetch.requestPaused")
         {
-            if (IsIpcCall(message)) 
+            const bool isIpcCall = IsIpcCall(message), isGetBodyCall = !isIpcCall && IsGetBodyCall(message);
+
+            HookProfiler::get().Begin(
+                message.value("/params/requestId"_json_pointer, std::string{}),
+                message.value("/params/request/url"_json_pointer, std::string{}),
+                isIpcCall ? "ipc" : isGetBodyCall ? "asset" : "document"
+            );
+
+            if (isIpcCall) 
             {
                 if (m_threadPool) {
                     m_threadPool->enqueue([this, msg = std::move(message)]() {
@@ -615,7 +880,7 @@ void HttpHookManager::DispatchSocketMessage(nlohmann::basic_json<> message)
                 return;
             }
 
-            switch ((int)this->IsGetBodyCall(message))
+            switch ((int)isGetBodyCall)
             {
                 case true:  { this->RetrieveRequestFromDisk(message); break; }
                 case false: { this->GetResponseBody(message);         break; }
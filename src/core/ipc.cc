@@ -106,6 +106,9 @@ MILLENNIUM nlohmann::json OnFrontEndLoaded(nlohmann::basic_json<> message)
 {
     const std::string pluginName = message["data"]["pluginName"];
 
+    /** Start any frontend calls the plugin's backend made before its frontend was around. */
+    JavaScript::MarkFrontendReady(pluginName);
+
     std::unique_ptr<SettingsStore> settingsStore = std::make_unique<SettingsStore>();
     const auto allPlugins = settingsStore->ParseAllPlugins();
 
@@ -0,0 +1,215 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "js_escape.h"
+#include "fvisible.h"
+#include <cstdint>
+
+#if (defined(__i386__) || defined(__x86_64__)) && (defined(__GNUC__) || defined(__clang__))
+#define MILLENNIUM_ESCAPE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define MILLENNIUM_ESCAPE_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * Bytes that may need escaping, the escaper decides what to do with them.
+ * '<' and 0xE2 (the lead byte of U+2028/U+2029) are only escaped as part of a longer sequence, 
+ * '\'' is only escaped in the String context.
+ */
+static inline bool IsCandidate(uint8_t c)
+{
+    return c < 0x20 || c == '"' || c == '\\' || c == '\'' || c == '<' || c == 0xE2;
+}
+
+using ScanKernel = size_t (*)(const uint8_t* data, size_t length, size_t offset);
+
+/**
+ * @brief Get the position of the next candidate byte at or after `offset`, or `length` if there is none.
+ */
+static size_t ScanScalar(const uint8_t* data, size_t length, size_t offset)
+{
+    while (offset < length && !IsCandidate(data[offset])) offset++;
+    return offset;
+}
+
+#ifdef MILLENNIUM_ESCAPE_SSE2
+__attribute__((target("sse2"))) static size_t ScanSSE2(const uint8_t* data, size_t length, size_t offset)
+{
+    const __m128i controlLimit = _mm_set1_epi8(0x1F);
+    const __m128i doubleQuote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'), singleQuote = _mm_set1_epi8('\'');
+    const __m128i lessThan = _mm_set1_epi8('<'), separatorLead = _mm_set1_epi8((char)0xE2);
+
+    for (; offset + 16 <= length; offset += 16) 
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+
+        /** max(c, 0x1F) == 0x1F is an unsigned c <= 0x1F */
+        __m128i candidates = _mm_cmpeq_epi8(_mm_max_epu8(chunk, controlLimit), controlLimit);
+        candidates = _mm_or_si128(candidates, _mm_cmpeq_epi8(chunk, doubleQuote));
+        candidates = _mm_or_si128(candidates, _mm_cmpeq_epi8(chunk, backslash));
+        candidates = _mm_or_si128(candidates, _mm_cmpeq_epi8(chunk, singleQuote));
+        candidates = _mm_or_si128(candidates, _mm_cmpeq_epi8(chunk, lessThan));
+        candidates = _mm_or_si128(candidates, _mm_cmpeq_epi8(chunk, separatorLead));
+
+        if (const int mask = _mm_movemask_epi8(candidates)) 
+        {
+            return offset + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return ScanScalar(data, length, offset);
+}
+#endif
+
+#ifdef MILLENNIUM_ESCAPE_NEON
+static size_t ScanNEON(const uint8_t* data, size_t length, size_t offset)
+{
+    for (; offset + 16 <= length; offset += 16) 
+    {
+        const uint8x16_t chunk = vld1q_u8(data + offset);
+
+        uint8x16_t candidates = vcleq_u8(chunk, vdupq_n_u8(0x1F));
+        candidates = vorrq_u8(candidates, vceqq_u8(chunk, vdupq_n_u8('"')));
+        candidates = vorrq_u8(candidates, vceqq_u8(chunk, vdupq_n_u8('\\')));
+        candidates = vorrq_u8(candidates, vceqq_u8(chunk, vdupq_n_u8('\'')));
+        candidates = vorrq_u8(candidates, vceqq_u8(chunk, vdupq_n_u8('<')));
+        candidates = vorrq_u8(candidates, vceqq_u8(chunk, vdupq_n_u8(0xE2)));
+
+        if (vmaxvq_u8(candidates)) 
+        {
+            return ScanScalar(data, offset + 16, offset);
+        }
+    }
+    return ScanScalar(data, length, offset);
+}
+#endif
+
+static ScanKernel GetScanKernel()
+{
+    static const ScanKernel kernel = []() -> ScanKernel 
+    {
+#if defined(MILLENNIUM_ESCAPE_SSE2)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse2")) return ScanSSE2;
+#elif defined(MILLENNIUM_ESCAPE_NEON)
+        return ScanNEON;
+#endif
+        return ScanScalar;
+    }();
+
+    return kernel;
+}
+
+MILLENNIUM void JavaScript::EscapeStringInto(std::string_view input, std::string& output, EscapeContext context)
+{
+    static constexpr char hexDigits[] = "0123456789ABCDEF";
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+    const size_t length = input.size();
+    const ScanKernel scan = GetScanKernel();
+
+    /** Most strings need few escapes, a little headroom avoids regrowing for them. */
+    output.reserve(output.size() + length + (length >> 4) + 8);
+
+    size_t runStart = 0;
+    size_t position = scan(data, length, 0);
+
+    while (position < length) 
+    {
+        const uint8_t c = data[position];
+        std::string_view escape;
+        size_t consumed = 1;
+        char unicodeEscape[6] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0x0F] };
+
+        switch (c) 
+        {
+            case '"':  escape = "\\\""; break;
+            case '\\': escape = "\\\\"; break;
+            case '\b': escape = "\\b";  break;
+            case '\f': escape = "\\f";  break;
+            case '\n': escape = "\\n";  break;
+            case '\r': escape = "\\r";  break;
+            case '\t': escape = "\\t";  break;
+            case '\'': 
+            {
+                if (context == EscapeContext::String) escape = "\\'";
+                break;
+            }
+            case '<': 
+            {
+                /** "</script>" and "<!--" would end or alter a surrounding script element. */
+                if (position + 1 < length && data[position + 1] == '/') 
+                {
+                    escape = "<\\/";
+                    consumed = 2;
+                }
+                else if (input.compare(position, 4, "<!--") == 0) 
+                {
+                    escape = "\\u003C";
+                }
+                break;
+            }
+            case 0xE2: 
+            {
+                /** U+2028 and U+2029 are E2 80 A8 and E2 80 A9 in UTF-8. */
+                if (position + 2 < length && data[position + 1] == 0x80 && (data[position + 2] == 0xA8 || data[position + 2] == 0xA9)) 
+                {
+                    escape = data[position + 2] == 0xA8 ? "\\u2028" : "\\u2029";
+                    consumed = 3;
+                }
+                break;
+            }
+            default: 
+            {
+                /** Remaining control characters are emitted as unicode escapes. */
+                if (c < 0x20) escape = std::string_view(unicodeEscape, sizeof(unicodeEscape));
+                break;
+            }
+        }
+
+        if (!escape.empty()) 
+        {
+            output.append(input.data() + runStart, position - runStart).append(escape.data(), escape.size());
+            runStart = position + consumed;
+        }
+
+        position = scan(data, length, position + consumed);
+    }
+
+    output.append(input.data() + runStart, length - runStart);
+}
+
+MILLENNIUM std::string JavaScript::EscapeString(std::string_view input, EscapeContext context)
+{
+    std::string escaped;
+    EscapeStringInto(input, escaped, context);
+    return escaped;
+}
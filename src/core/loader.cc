@@ -39,6 +39,10 @@
 #include "ffi.h"
 #include "http.h"
 #include "http_hooks.h"
+#include "target_tracker.h"
+#include "backend_events.h"
+#include "frontend_console.h"
+#include "cdp_passthrough.h"
 #include "internal_logger.h"
 #include "plugin_logger.h"
 #include <env.h>
@@ -69,6 +73,17 @@ MILLENNIUM bool Sockets::PostShared(nlohmann::json data)
     return Sockets::PostGlobal(data);
 }
 
+/**
+ * @brief Check whether a message was received on Millennium's SharedJSContext session.
+ * Events from other sessions (i.e web pages plugins attached to) must never be trusted like the SharedJSContext.
+ * 
+ * @note Only call this from the socket thread, which is the only writer of the session id.
+ */
+MILLENNIUM bool Sockets::IsSharedJsContextMessage(const nlohmann::json& message)
+{
+    return !sharedJsContextSessionId.empty() && message.value("sessionId", std::string()) == sharedJsContextSessionId;
+}
+
 /**
  * @brief Post a message to the entire browser.
  * @param data The data to post.
@@ -104,6 +119,10 @@ MILLENNIUM void Sockets::Shutdown()
     {
         LOG_ERROR("Failed to close browser connection: {}", e.what());
     }
+
+    BackendEventChannel::get().Shutdown();
+    JavaScript::CancelDeferredFrontendCalls();
+    CdpPassthrough::get().Shutdown();
 }
 
 class MILLENNIUM CEFBrowser
@@ -139,6 +158,11 @@ public:
         {
             sharedJsContextSessionId = json["params"]["sessionId"];
             Sockets::PostShared({ { "id", 9494 }, { "method", "Log.enable "}, { "sessionId", sharedJsContextSessionId } });
+            /** Runtime events tell the frontend method cache when the handles it holds die with their context. */
+            JavaScript::ResetFrontendMethodCache();
+            JavaScript::ResetFrontendReadiness();
+            Sockets::PostShared({ { "id", 9495 }, { "method", "Runtime.enable" } });
+            BackendEventChannel::get().Attach();
             this->onSharedJsConnect();
         }
         else
@@ -146,6 +170,10 @@ public:
             JavaScript::SharedJSMessageEmitter::InstanceRef().EmitMessage("msg", json);
         }
         webKitHandler.DispatchSocketMessage(json);
+        TargetTracker::get().DispatchSocketMessage(json);
+        BackendEventChannel::get().DispatchSocketMessage(json);
+        FrontendConsole::get().DispatchSocketMessage(json);
+        CdpPassthrough::get().DispatchSocketMessage(json);
     }
 
     MILLENNIUM const void SetupSharedJSContext()
@@ -171,6 +199,7 @@ public:
 
         this->SetupSharedJSContext();
         webKitHandler.SetupGlobalHooks();
+        TargetTracker::get().SetupTargetDiscovery();
     }
 
     MILLENNIUM CEFBrowser() : webKitHandler(HttpHookManager::get()) {}
@@ -182,6 +211,7 @@ MILLENNIUM const void PluginLoader::Initialize()
     m_settingsStorePtr  = std::make_unique<SettingsStore>();
     m_pluginsPtr        = std::make_shared<std::vector<SettingsStore::PluginTypeSchema>>(m_settingsStorePtr->ParseAllPlugins());
     m_enabledPluginsPtr = std::make_shared<std::vector<SettingsStore::PluginTypeSchema>>(m_settingsStorePtr->GetEnabledBackends());
+    FrontendConsole::get().SetPlugins(*m_pluginsPtr);
 
     m_settingsStorePtr->InitializeSettingsStore();
 }
@@ -204,6 +234,60 @@ MILLENNIUM std::shared_ptr<std::thread> PluginLoader::ConnectCEFBrowser(void* ce
     return std::make_shared<std::thread>(std::thread(std::bind(&SocketHelpers::ConnectSocket, socketHelpers, browserProps)));
 }
 
+/**
+ * @brief Build the URL scope a plugin's webkit module is injected into.
+ * 
+ * Plugins may declare `webkit_matches` in their plugin.json, a list of regular expressions matched against the page URL.
+ * Without it the webkit module is loaded into every page, which was the behavior before scopes existed.
+ * 
+ * @returns std::nullopt if the plugin explicitly targets no pages, or if any of its patterns is invalid.
+ */
+MILLENNIUM std::optional<std::regex> GetWebkitUrlScope(const SettingsStore::PluginTypeSchema& plugin)
+{
+    const nlohmann::json urlMatches = plugin.pluginJson.value("webkit_matches", nlohmann::json());
+
+    if (urlMatches.is_null())
+    {
+        return std::regex(".*");
+    }
+
+    std::vector<std::string> patterns;
+
+    if (urlMatches.is_string())
+    {
+        patterns.push_back(urlMatches.get<std::string>());
+    }
+    else if (urlMatches.is_array())
+    {
+        for (const auto& pattern : urlMatches)
+        {
+            if (pattern.is_string()) patterns.push_back(pattern.get<std::string>());
+        }
+    }
+
+    if (patterns.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::string combinedPattern;
+    for (size_t i = 0; i < patterns.size(); i++)
+    {
+        combinedPattern.append(fmt::format("(?:{}){}", patterns[i], (i == patterns.size() - 1 ? "" : "|")));
+    }
+
+    try
+    {
+        return std::regex(combinedPattern);
+    }
+    catch (const std::regex_error& error)
+    {
+        LOG_ERROR("Invalid webkit_matches in '{}' ({}): {}, skipping its webkit module.", plugin.pluginName, combinedPattern, error.what());
+        ErrorToLogger(plugin.pluginName, fmt::format("Invalid webkit_matches in plugin.json ({}): {}, the webkit module was not loaded.", combinedPattern, error.what()));
+        return std::nullopt;
+    }
+}
+
 /**
  * @brief Injects webkit shims into the SteamUI.    
  * All hooks are internally stored in the function and are removed upon re-injection. 
@@ -243,11 +327,19 @@ MILLENNIUM const void PluginLoader::InjectWebkitShims()
 
         if (this->m_settingsStorePtr->IsEnabledPlugin(plugin.pluginName) && std::filesystem::exists(absolutePath))
         {
+            const std::optional<std::regex> urlScope = GetWebkitUrlScope(plugin);
+
+            if (!urlScope.has_value())
+            {
+                Logger.Log("Skipping webkit hook for '{}', it doesn't target any valid pages", plugin.pluginName);
+                continue;
+            }
+
             g_hookedModuleId++;
             hookIds.push_back(g_hookedModuleId);
 
             Logger.Log("Injecting hook for '{}' with id {}", plugin.pluginName, g_hookedModuleId.load());
-            HttpHookManager::get().AddHook({ absolutePath.generic_string(), std::regex(".*"), HttpHookManager::TagTypes::JAVASCRIPT, g_hookedModuleId });
+            HttpHookManager::get().AddHook({ absolutePath.generic_string(), urlScope.value(), HttpHookManager::TagTypes::JAVASCRIPT, g_hookedModuleId });
         }
     }
 }
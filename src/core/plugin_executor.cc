@@ -0,0 +1,277 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * plugin_executor.cc
+ *
+ * Per plugin work queue that runs against one persistent Python thread state, see PluginExecutor.
+ */
+#include "plugin_executor.h"
+#include "internal_logger.h"
+#include "fvisible.h"
+
+/** The executor the calling thread belongs to, only set on executor threads. */
+static thread_local std::weak_ptr<PluginExecutor> currentExecutor;
+
+MILLENNIUM PluginExecutor::PluginExecutor(std::string pluginName, PyInterpreterState* interpreter) 
+    : m_pluginName(std::move(pluginName)), m_interpreter(interpreter) 
+{ }
+
+MILLENNIUM PluginExecutor::~PluginExecutor()
+{
+    if (m_thread.joinable()) 
+    {
+        /** The last reference can only be dropped on the executor itself if Stop was never called, don't join ourselves. */
+        if (this->IsCurrentThread()) m_thread.detach();
+        else                         this->Stop();
+    }
+}
+
+/**
+ * @brief Start the executor thread, it creates its thread state on the plugin's interpreter.
+ * @note Has to be called once the executor is owned by a std::shared_ptr.
+ */
+MILLENNIUM void PluginExecutor::Start()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_thread = std::thread(&PluginExecutor::Run, this);
+    m_threadId = m_thread.get_id();
+}
+
+/**
+ * @brief Stop accepting work, run everything that was already posted, and release the thread state.
+ * Must not be called from the executor thread, and has to be called before the plugin's interpreter is ended.
+ */
+MILLENNIUM void PluginExecutor::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    if (m_thread.joinable()) 
+    {
+        m_thread.join();
+    }
+}
+
+/**
+ * @brief Queue `task` to run on the executor with the plugin's GIL held.
+ * Tasks must not own Python references, a task that is never run is destroyed without the GIL.
+ * 
+ * @returns {bool} - false if the executor has been stopped, the task is dropped.
+ */
+MILLENNIUM bool PluginExecutor::Post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_stopping) 
+        {
+            return false;
+        }
+        m_queue.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+    return true;
+}
+
+/**
+ * @brief Run `task` on the calling thread with the plugin's GIL held, on a thread state of its own.
+ * 
+ * For work the executor can't get to because the task it is running waits on it, i.e an event loop that task 
+ * started with asyncio.run is waiting on a result only `task` delivers. Blocks the caller until it has the GIL.
+ * The executor doesn't release its thread state (and with it the interpreter) until every such task has returned.
+ * 
+ * @returns {bool} - false if the executor has already finished, the task isn't run.
+ */
+MILLENNIUM bool PluginExecutor::RunAlongside(const Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_finished) 
+        {
+            return false;
+        }
+        m_runningAlongside++;
+    }
+
+    PyThreadState* threadState = PyThreadState_New(m_interpreter);
+    PyEval_RestoreThread(threadState);
+
+    try 
+    {
+        task();
+    }
+    catch (const std::exception& ex) 
+    {
+        LOG_ERROR("Unhandled exception in a task of plugin [{}]: {}", m_pluginName, ex.what());
+    }
+
+    PyThreadState_Clear(threadState);
+    PyThreadState_DeleteCurrent();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_runningAlongside--;
+    }
+    m_condition.notify_all();
+    return true;
+}
+
+MILLENNIUM bool PluginExecutor::IsCurrentThread() const
+{
+    return std::this_thread::get_id() == m_threadId;
+}
+
+/**
+ * @brief Get the executor the calling thread belongs to.
+ * @returns {std::shared_ptr<PluginExecutor>} - nullptr if the calling thread isn't an executor thread.
+ */
+MILLENNIUM std::shared_ptr<PluginExecutor> PluginExecutor::Current()
+{
+    return currentExecutor.lock();
+}
+
+/**
+ * @brief Wake an executor that is waiting in RunPendingUntil so it checks its condition again.
+ */
+MILLENNIUM void PluginExecutor::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeSequence++;
+    }
+    m_condition.notify_one();
+}
+
+/**
+ * @brief Keep running posted work on the executor thread until `isDone` returns true or `deadline` passes.
+ * 
+ * Called from a task that has to block with the GIL released, i.e while waiting for the frontend. Whoever makes 
+ * `isDone` true has to call Wake afterwards.
+ * 
+ * @returns {bool} - The last result of `isDone`.
+ */
+MILLENNIUM bool PluginExecutor::RunPendingUntil(const std::function<bool()>& isDone, std::chrono::steady_clock::time_point deadline)
+{
+    std::deque<Task> batch;
+
+    while (true) 
+    {
+        uint64_t wakeSequence;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            wakeSequence = m_wakeSequence;
+        }
+
+        if (isDone()) 
+        {
+            return true;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (!m_condition.wait_until(lock, deadline, [&] { return !m_queue.empty() || m_wakeSequence != wakeSequence; })) 
+            {
+                return isDone();
+            }
+            batch.swap(m_queue);
+        }
+
+        if (!batch.empty()) 
+        {
+            this->RunBatch(batch);
+        }
+    }
+}
+
+/**
+ * @brief Run `batch` in order with the GIL held on the executor's thread state, leaving it empty.
+ */
+MILLENNIUM void PluginExecutor::RunBatch(std::deque<Task>& batch)
+{
+    PyEval_RestoreThread(m_threadState);
+
+    while (!batch.empty()) 
+    {
+        Task task = std::move(batch.front());
+        batch.pop_front();
+
+        try 
+        {
+            task();
+        }
+        catch (const std::exception& ex) 
+        {
+            LOG_ERROR("Unhandled exception in a task of plugin [{}]: {}", m_pluginName, ex.what());
+        }
+    }
+
+    PyEval_SaveThread();
+}
+
+MILLENNIUM void PluginExecutor::Run()
+{
+    currentExecutor = weak_from_this();
+    m_threadState = PyThreadState_New(m_interpreter);
+
+    std::deque<Task> batch;
+
+    while (true) 
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+
+            /** Only exit once everything posted before Stop has run, callers may be waiting on it. */
+            if (m_queue.empty()) 
+            {
+                break;
+            }
+            batch.swap(m_queue);
+        }
+
+        this->RunBatch(batch);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished = true;
+        m_condition.wait(lock, [this] { return m_runningAlongside == 0; });
+    }
+
+    PyEval_RestoreThread(m_threadState);
+    PyThreadState_Clear(m_threadState);
+    PyThreadState_DeleteCurrent();
+    m_threadState = nullptr;
+}
@@ -0,0 +1,473 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * shm_ring.cc
+ *
+ * Shared memory message rings used to talk to out of process plugin backends, see ShmChannel.
+ */
+#include "shm_ring.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include "fvisible.h"
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace
+{
+    /** Keep both ring headers on their own cache line so the two directions don't contend. */
+    constexpr size_t RING_HEADER_SIZE = 64;
+    static_assert(sizeof(ShmRingHeader) <= RING_HEADER_SIZE, "ring header has to fit its cache line");
+
+    /** Doorbells of a channel, ring 0 carries host -> child, ring 1 child -> host. */
+    enum DoorbellIndex { HOST_DATA, HOST_SPACE, CHILD_DATA, CHILD_SPACE, DOORBELL_COUNT };
+
+    #ifdef _WIN32
+    SECURITY_ATTRIBUTES* InheritableAttributes()
+    {
+        static SECURITY_ATTRIBUTES attributes { sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+        return &attributes;
+    }
+    #endif
+}
+
+MILLENNIUM std::optional<Doorbell> Doorbell::Create()
+{
+    #ifdef _WIN32
+    {
+        HANDLE event = CreateEventW(InheritableAttributes(), FALSE, FALSE, nullptr);
+        if (event == nullptr)
+            return std::nullopt;
+
+        return std::optional<Doorbell>(std::in_place, event);
+    }
+    #elif defined(__linux__)
+    {
+        /** Close on exec, the spawner clears the flag on the handles it hands to its child only. */
+        int fd = eventfd(0, EFD_CLOEXEC);
+        if (fd < 0)
+            return std::nullopt;
+
+        return std::optional<Doorbell>(std::in_place, fd);
+    }
+    #else
+    {
+        /** No eventfd on macOS, out of process backends are refused there (see BackendWorkers::Start). */
+        return std::nullopt;
+    }
+    #endif
+}
+
+MILLENNIUM Doorbell::Doorbell(Doorbell&& other) noexcept : m_handle(other.m_handle)
+{
+    #ifdef _WIN32
+    other.m_handle = nullptr;
+    #else
+    other.m_handle = -1;
+    #endif
+}
+
+MILLENNIUM Doorbell::~Doorbell()
+{
+    #ifdef _WIN32
+    if (m_handle != nullptr) CloseHandle(m_handle);
+    #else
+    if (m_handle >= 0) close(m_handle);
+    #endif
+}
+
+MILLENNIUM void Doorbell::Ring()
+{
+    #ifdef _WIN32
+    {
+        SetEvent(m_handle);
+    }
+    #else
+    {
+        const uint64_t increment = 1;
+        while (write(m_handle, &increment, sizeof(increment)) < 0 && errno == EINTR) { }
+    }
+    #endif
+}
+
+/**
+ * @brief Block until the doorbell was rung at least once since the last wait, rings that happened in between are merged.
+ * @returns {bool} - False if the timeout elapsed first.
+ */
+MILLENNIUM bool Doorbell::Wait(std::chrono::milliseconds timeout)
+{
+    #ifdef _WIN32
+    {
+        return WaitForSingleObject(m_handle, static_cast<DWORD>(timeout.count())) == WAIT_OBJECT_0;
+    }
+    #else
+    {
+        pollfd descriptor { m_handle, POLLIN, 0 };
+
+        int ready = poll(&descriptor, 1, static_cast<int>(timeout.count()));
+        if (ready <= 0)
+            return false;
+
+        uint64_t counter;
+        return read(m_handle, &counter, sizeof(counter)) == sizeof(counter);
+    }
+    #endif
+}
+
+MILLENNIUM std::optional<SharedMemoryRegion> SharedMemoryRegion::Create(size_t size)
+{
+    #ifdef _WIN32
+    {
+        HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, InheritableAttributes(), PAGE_READWRITE, 0, static_cast<DWORD>(size), nullptr);
+        if (mapping == nullptr)
+            return std::nullopt;
+
+        std::optional<SharedMemoryRegion> region = Attach(mapping, size);
+        if (!region.has_value())
+            CloseHandle(mapping);
+
+        return region;
+    }
+    #elif defined(__linux__)
+    {
+        int fd = memfd_create("millennium-ring", MFD_CLOEXEC);
+        if (fd < 0)
+            return std::nullopt;
+
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            close(fd);
+            return std::nullopt;
+        }
+
+        std::optional<SharedMemoryRegion> region = Attach(fd, size);
+        if (!region.has_value())
+            close(fd);
+
+        return region;
+    }
+    #else
+    {
+        /** No memfd on macOS, see Doorbell::Create. */
+        return std::nullopt;
+    }
+    #endif
+}
+
+/**
+ * @brief Map a region created by another process, the region takes ownership of `handle` on success.
+ */
+MILLENNIUM std::optional<SharedMemoryRegion> SharedMemoryRegion::Attach(ShmHandle handle, size_t size)
+{
+    #ifdef _WIN32
+    {
+        void* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (data == nullptr)
+            return std::nullopt;
+
+        return SharedMemoryRegion(handle, data, size);
+    }
+    #else
+    {
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, handle, 0);
+        if (data == MAP_FAILED)
+            return std::nullopt;
+
+        return SharedMemoryRegion(handle, data, size);
+    }
+    #endif
+}
+
+MILLENNIUM SharedMemoryRegion::SharedMemoryRegion(SharedMemoryRegion&& other) noexcept 
+    : m_handle(other.m_handle), m_data(other.m_data), m_size(other.m_size)
+{
+    other.m_data = nullptr;
+    #ifdef _WIN32
+    other.m_handle = nullptr;
+    #else
+    other.m_handle = -1;
+    #endif
+}
+
+MILLENNIUM SharedMemoryRegion::~SharedMemoryRegion()
+{
+    #ifdef _WIN32
+    {
+        if (m_data != nullptr)   UnmapViewOfFile(m_data);
+        if (m_handle != nullptr) CloseHandle(m_handle);
+    }
+    #else
+    {
+        if (m_data != nullptr) munmap(m_data, m_size);
+        if (m_handle >= 0)     close(m_handle);
+    }
+    #endif
+}
+
+/**
+ * @brief Wrap a ring laid out by Initialize, both sides of the ring construct their own ShmRing over the same memory.
+ * 
+ * @param {void*} memory - The ring header followed by its data, `size` bytes in total.
+ * @param {Doorbell&} dataBell - Rung by the producer when a sleeping consumer has something to read.
+ * @param {Doorbell&} spaceBell - Rung by the consumer when a sleeping producer has room to write.
+ */
+MILLENNIUM ShmRing::ShmRing(void* memory, size_t size, Doorbell& dataBell, Doorbell& spaceBell)
+    : m_header(static_cast<ShmRingHeader*>(memory)), 
+      m_data(static_cast<uint8_t*>(memory) + RING_HEADER_SIZE), 
+      m_capacity(static_cast<uint32_t>(size - RING_HEADER_SIZE)), 
+      m_dataBell(dataBell), 
+      m_spaceBell(spaceBell)
+{ }
+
+/**
+ * @brief Lay out an empty ring, done once by the side that created the memory before anyone attaches.
+ * @param {size_t} size - Header plus data, the data part has to be a power of two so positions can wrap freely.
+ */
+MILLENNIUM void ShmRing::Initialize(void* memory, size_t size)
+{
+    ShmRingHeader* header = new (memory) ShmRingHeader();
+    header->head.store(0);
+    header->tail.store(0);
+    header->consumerWaiting.store(0);
+    header->producerWaiting.store(0);
+    header->capacity = static_cast<uint32_t>(size - RING_HEADER_SIZE);
+}
+
+MILLENNIUM void ShmRing::CopyIn(uint32_t position, const void* source, size_t length)
+{
+    const uint32_t offset = position & (m_capacity - 1);
+    const size_t firstPart = std::min<size_t>(length, m_capacity - offset);
+
+    std::memcpy(m_data + offset, source, firstPart);
+    std::memcpy(m_data, static_cast<const uint8_t*>(source) + firstPart, length - firstPart);
+}
+
+MILLENNIUM void ShmRing::CopyOut(uint32_t position, void* destination, size_t length) const
+{
+    const uint32_t offset = position & (m_capacity - 1);
+    const size_t firstPart = std::min<size_t>(length, m_capacity - offset);
+
+    std::memcpy(destination, m_data + offset, firstPart);
+    std::memcpy(static_cast<uint8_t*>(destination) + firstPart, m_data, length - firstPart);
+}
+
+/**
+ * @brief Append a message, waiting for the consumer to make room if the ring is full.
+ * @returns {bool} - False if the message can never fit or the consumer didn't make room in time.
+ */
+MILLENNIUM bool ShmRing::Write(std::string_view message, std::chrono::milliseconds timeout)
+{
+    if (message.size() > GetMaxMessageSize())
+        return false;
+
+    const uint32_t length = static_cast<uint32_t>(message.size());
+    const uint32_t required = sizeof(length) + length;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    const uint32_t tail = m_header->tail.load(std::memory_order_relaxed);
+
+    while (m_capacity - (tail - m_header->head.load(std::memory_order_acquire)) < required)
+    {
+        /** Announce that we are about to sleep, then look again so a consumer that drained the ring in between isn't missed. */
+        m_header->producerWaiting.store(1);
+
+        if (m_capacity - (tail - m_header->head.load()) < required)
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+            if (remaining.count() <= 0 || !m_spaceBell.Wait(remaining))
+            {
+                m_header->producerWaiting.store(0);
+                return false;
+            }
+        }
+        m_header->producerWaiting.store(0);
+    }
+
+    CopyIn(tail, &length, sizeof(length));
+    CopyIn(tail + sizeof(length), message.data(), length);
+    m_header->tail.store(tail + required);
+
+    if (m_header->consumerWaiting.load())
+        m_dataBell.Ring();
+
+    return true;
+}
+
+/**
+ * @brief Take the oldest message, waiting for the producer if the ring is empty.
+ * 
+ * The positions and the length prefix live in memory the producer can write anything to. A message that claims 
+ * more than the producer published, or more than fits the ring, marks the ring corrupt instead of being read.
+ * 
+ * @returns {bool} - False if nothing arrived in time, or if the ring is corrupt (see IsCorrupt).
+ */
+MILLENNIUM bool ShmRing::Read(std::string& message, std::chrono::milliseconds timeout)
+{
+    if (m_isCorrupt)
+        return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    const uint32_t head = m_header->head.load(std::memory_order_relaxed);
+
+    uint32_t tail;
+    while ((tail = m_header->tail.load(std::memory_order_acquire)) == head)
+    {
+        m_header->consumerWaiting.store(1);
+
+        if (m_header->tail.load() == head)
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+            if (remaining.count() <= 0 || !m_dataBell.Wait(remaining))
+            {
+                m_header->consumerWaiting.store(0);
+                return false;
+            }
+        }
+        m_header->consumerWaiting.store(0);
+    }
+
+    const uint32_t available = tail - head;
+
+    if (available > m_capacity || available < sizeof(uint32_t))
+    {
+        m_isCorrupt = true;
+        return false;
+    }
+
+    uint32_t length;
+    CopyOut(head, &length, sizeof(length));
+
+    if (length > available - sizeof(length) || length > GetMaxMessageSize())
+    {
+        m_isCorrupt = true;
+        return false;
+    }
+
+    message.resize(length);
+    CopyOut(head + sizeof(length), message.data(), length);
+    m_header->head.store(head + sizeof(length) + length);
+
+    if (m_header->producerWaiting.load())
+        m_spaceBell.Ring();
+
+    return true;
+}
+
+MILLENNIUM ShmChannel::ShmChannel(SharedMemoryRegion region, std::vector<Doorbell> doorbells, size_t ringSize, bool isHost)
+    : m_region(std::move(region)), m_doorbells(std::move(doorbells))
+{
+    uint8_t* base = static_cast<uint8_t*>(m_region.GetData());
+
+    auto hostToChild = std::make_unique<ShmRing>(base, ringSize, m_doorbells[HOST_DATA], m_doorbells[HOST_SPACE]);
+    auto childToHost = std::make_unique<ShmRing>(base + ringSize, ringSize, m_doorbells[CHILD_DATA], m_doorbells[CHILD_SPACE]);
+
+    m_outbound = isHost ? std::move(hostToChild) : std::move(childToHost);
+    m_inbound  = isHost ? std::move(childToHost) : std::move(hostToChild);
+}
+
+/**
+ * @brief Create a channel to hand to a child process.
+ * @param {size_t} ringSize - Bytes per direction including the ring header, the remainder has to be a power of two.
+ */
+MILLENNIUM std::unique_ptr<ShmChannel> ShmChannel::Create(size_t ringSize)
+{
+    std::optional<SharedMemoryRegion> region = SharedMemoryRegion::Create(ringSize * 2);
+    if (!region.has_value())
+        return nullptr;
+
+    std::vector<Doorbell> doorbells;
+    doorbells.reserve(DOORBELL_COUNT);
+
+    for (int i = 0; i < DOORBELL_COUNT; i++)
+    {
+        std::optional<Doorbell> doorbell = Doorbell::Create();
+        if (!doorbell.has_value())
+            return nullptr;
+
+        doorbells.push_back(std::move(*doorbell));
+    }
+
+    ShmRing::Initialize(region->GetData(), ringSize);
+    ShmRing::Initialize(static_cast<uint8_t*>(region->GetData()) + ringSize, ringSize);
+
+    return std::unique_ptr<ShmChannel>(new ShmChannel(std::move(*region), std::move(doorbells), ringSize, true));
+}
+
+/**
+ * @brief Attach to a channel created by the parent process, the channel takes ownership of the handles on success.
+ */
+MILLENNIUM std::unique_ptr<ShmChannel> ShmChannel::Attach(const std::vector<ShmHandle>& handles, size_t ringSize)
+{
+    if (handles.size() != HANDLE_COUNT)
+        return nullptr;
+
+    std::optional<SharedMemoryRegion> region = SharedMemoryRegion::Attach(handles[0], ringSize * 2);
+    if (!region.has_value())
+        return nullptr;
+
+    std::vector<Doorbell> doorbells;
+    doorbells.reserve(DOORBELL_COUNT);
+
+    for (size_t i = 1; i < HANDLE_COUNT; i++)
+        doorbells.emplace_back(handles[i]);
+
+    return std::unique_ptr<ShmChannel>(new ShmChannel(std::move(*region), std::move(doorbells), ringSize, false));
+}
+
+MILLENNIUM bool ShmChannel::Send(std::string_view message, std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(m_sendMutex);
+    return m_outbound->Write(message, timeout);
+}
+
+MILLENNIUM bool ShmChannel::Receive(std::string& message, std::chrono::milliseconds timeout)
+{
+    return m_inbound->Read(message, timeout);
+}
+
+MILLENNIUM std::vector<ShmHandle> ShmChannel::GetInheritableHandles() const
+{
+    std::vector<ShmHandle> handles { m_region.GetHandle() };
+
+    for (const Doorbell& doorbell : m_doorbells)
+        handles.push_back(doorbell.GetHandle());
+
+    return handles;
+}
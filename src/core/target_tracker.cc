@@ -0,0 +1,247 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * target_tracker.cc
+ *
+ * Keeps track of every CEF target (pages, popups, workers) over the browser connection.
+ *
+ * Millennium bypasses the Content Security Policy (CSP) of web pages so injected modules may do things the page would
+ * otherwise block, i.e making requests to external servers, loading scripts from external sources, etc.
+ * Page.setBypassCSP is a per-page setting that survives navigations, so it only needs to be sent once after Millennium attaches.
+ */
+#include "target_tracker.h"
+#include "loader.h"
+#include "internal_logger.h"
+#include "fvisible.h"
+
+enum TargetMessageId
+{
+    TARGET_DISCOVER   = 96876,
+    TARGET_ATTACH     = 567844,
+    TARGET_BYPASS_CSP = 1235377
+};
+
+MILLENNIUM TargetTracker& TargetTracker::get()
+{
+    static TargetTracker instance;
+    return instance;
+}
+
+/**
+ * @brief Start receiving target lifecycle events for the current browser connection.
+ * Chromium replays Target.targetCreated for every existing target once discovery is enabled.
+ */
+MILLENNIUM void TargetTracker::SetupTargetDiscovery()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_targetMutex);
+        m_targets.clear();
+    }
+
+    Sockets::PostGlobal({
+        { "id", TARGET_DISCOVER },
+        { "method", "Target.setDiscoverTargets" },
+        { "params", { { "discover", true } } }
+    });
+}
+
+/**
+ * @brief Only web pages outside of the Steam client need per-target setup.
+ * Client pages (steamloopback.host) and Steam's own popup windows are left untouched.
+ */
+MILLENNIUM bool TargetTracker::ShouldAttach(const TargetItem& target) const
+{
+    return target.type == "page" 
+        && target.url.find("steamloopback.host") == std::string::npos 
+        && target.url.find("about:blank?") == std::string::npos;
+}
+
+MILLENNIUM void TargetTracker::UpdateTarget(const nlohmann::json& targetInfo)
+{
+    const std::string targetId = targetInfo.value("targetId", std::string());
+    bool shouldAttach = false;
+
+    if (targetId.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_targetMutex);
+        TargetItem& target = m_targets[targetId];
+
+        target.targetId = targetId;
+        target.type     = targetInfo.value("type",  std::string());
+        target.url      = targetInfo.value("url",   std::string());
+        target.title    = targetInfo.value("title", std::string());
+
+        if (target.sessionId.empty() && !target.isAttachPending && this->ShouldAttach(target))
+        {
+            target.isAttachPending = true;
+            shouldAttach = true;
+        }
+    }
+
+    if (shouldAttach)
+    {
+        Sockets::PostGlobal({
+            { "id", TARGET_ATTACH },
+            { "method", "Target.attachToTarget" },
+            { "params", { { "targetId", targetId }, { "flatten", true } } }
+        });
+    }
+}
+
+MILLENNIUM void TargetTracker::OnAttachedToTarget(const nlohmann::json& params)
+{
+    const std::string sessionId = params.value("sessionId", std::string());
+    const nlohmann::json targetInfo = params.value("targetInfo", nlohmann::json::object());
+    const std::string targetId = targetInfo.value("targetId", std::string());
+    bool isOwnAttach = false;
+
+    if (sessionId.empty() || targetId.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_targetMutex);
+        TargetItem& target = m_targets[targetId];
+
+        target.targetId = targetId;
+        target.type     = targetInfo.value("type",  target.type);
+        target.url      = targetInfo.value("url",   target.url);
+        target.title    = targetInfo.value("title", target.title);
+
+        /** Other parts of Millennium attach to targets too (i.e the SharedJSContext), only set up the ones requested here. */
+        isOwnAttach = target.isAttachPending && target.sessionId.empty();
+
+        target.sessionId = sessionId;
+        target.isAttachPending = false;
+        target.isCspBypassed = isOwnAttach;
+    }
+
+    if (isOwnAttach)
+    {
+        this->ApplyTargetSetup(sessionId);
+    }
+}
+
+MILLENNIUM void TargetTracker::OnDetachedFromTarget(const nlohmann::json& params)
+{
+    const std::string sessionId = params.value("sessionId", std::string());
+    std::lock_guard<std::mutex> lock(m_targetMutex);
+
+    for (auto& [targetId, target] : m_targets)
+    {
+        if (target.sessionId == sessionId)
+        {
+            target.sessionId.clear();
+            target.isAttachPending = false;
+            target.isCspBypassed = false;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Setup applied exactly once for every target Millennium attaches to.
+ */
+MILLENNIUM void TargetTracker::ApplyTargetSetup(const std::string& sessionId)
+{
+    Sockets::PostGlobal({
+        { "id", TARGET_BYPASS_CSP },
+        { "method", "Page.setBypassCSP" },
+        { "sessionId", sessionId },
+        { "params", { { "enabled", true } } }
+    });
+}
+
+MILLENNIUM void TargetTracker::DispatchSocketMessage(const nlohmann::json& message)
+{
+    try
+    {
+        const std::string method = message.value("method", std::string());
+
+        if (method.rfind("Target.", 0) != 0 || message.contains("sessionId"))
+        {
+            return;
+        }
+
+        if (method == "Target.targetCreated" || method == "Target.targetInfoChanged")
+        {
+            this->UpdateTarget(message["params"]["targetInfo"]);
+        }
+        else if (method == "Target.attachedToTarget")
+        {
+            this->OnAttachedToTarget(message["params"]);
+        }
+        else if (method == "Target.detachedFromTarget")
+        {
+            this->OnDetachedFromTarget(message["params"]);
+        }
+        else if (method == "Target.targetDestroyed")
+        {
+            std::lock_guard<std::mutex> lock(m_targetMutex);
+            m_targets.erase(message["params"].value("targetId", std::string()));
+        }
+    }
+    catch (const nlohmann::detail::exception& ex)
+    {
+        LOG_ERROR("error tracking target -> {}", ex.what());
+    }
+}
+
+MILLENNIUM std::unordered_map<std::string, TargetTracker::TargetItem> TargetTracker::GetTargetsCopy() const
+{
+    std::lock_guard<std::mutex> lock(m_targetMutex);
+    return m_targets;
+}
+
+MILLENNIUM std::string TargetTracker::GetSessionId(const std::string& targetId) const
+{
+    std::lock_guard<std::mutex> lock(m_targetMutex);
+    auto target = m_targets.find(targetId);
+
+    return target != m_targets.end() ? target->second.sessionId : std::string();
+}
+
+/**
+ * @brief Whether the Content Security Policy of a target has been bypassed by Millennium.
+ * Page.setBypassCSP is sent right after attaching, so this is optimistic by the length of one round trip.
+ */
+MILLENNIUM bool TargetTracker::IsCspBypassed(const std::string& targetId) const
+{
+    std::lock_guard<std::mutex> lock(m_targetMutex);
+    auto target = m_targets.find(targetId);
+
+    return target != m_targets.end() && target->second.isCspBypassed;
+}
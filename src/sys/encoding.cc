@@ -0,0 +1,501 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "encoding.h"
+#include "fvisible.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__i386__) || defined(__x86_64__)) && (defined(__GNUC__) || defined(__clang__))
+#define MILLENNIUM_BASE64_X86
+#define MILLENNIUM_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define MILLENNIUM_BASE64_NEON
+#include <arm_neon.h>
+#endif
+
+static constexpr char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static constexpr uint8_t invalidCharacter = 0xFF;
+
+static constexpr std::array<uint8_t, 256> MakeDecodeTable()
+{
+    std::array<uint8_t, 256> table{};
+
+    for (size_t i = 0; i < table.size(); i++) table[i] = invalidCharacter;
+    for (size_t i = 0; i < 64; i++)           table[(uint8_t)base64Alphabet[i]] = (uint8_t)i;
+
+    return table;
+}
+
+static constexpr std::array<uint8_t, 256> base64DecodeTable = MakeDecodeTable();
+
+/**
+ * SIMD kernels only ever process whole blocks and return how much input they consumed (a multiple of 3 when encoding, 4 when decoding).
+ * Decoders stop at the first block containing anything besides the alphabet (padding, whitespace, garbage), 
+ * the scalar codec then takes over and applies the requested decode mode to the rest of the input.
+ */
+using EncodeKernel = size_t (*)(const uint8_t* source, size_t length, char* output);
+using DecodeKernel = size_t (*)(const char* source, size_t length, uint8_t* output);
+
+static size_t EncodeScalar(const uint8_t* source, size_t length, char* output)
+{
+    char* cursor = output;
+    size_t i = 0;
+
+    for (; i + 3 <= length; i += 3, cursor += 4) 
+    {
+        const uint32_t triple = (uint32_t(source[i]) << 16) | (uint32_t(source[i + 1]) << 8) | source[i + 2];
+
+        cursor[0] = base64Alphabet[(triple >> 18) & 0x3F];
+        cursor[1] = base64Alphabet[(triple >> 12) & 0x3F];
+        cursor[2] = base64Alphabet[(triple >> 6)  & 0x3F];
+        cursor[3] = base64Alphabet[triple & 0x3F];
+    }
+
+    if (length - i == 1) 
+    {
+        cursor[0] = base64Alphabet[source[i] >> 2];
+        cursor[1] = base64Alphabet[(source[i] & 0x03) << 4];
+        cursor[2] = '=';
+        cursor[3] = '=';
+        cursor += 4;
+    }
+    else if (length - i == 2) 
+    {
+        cursor[0] = base64Alphabet[source[i] >> 2];
+        cursor[1] = base64Alphabet[((source[i] & 0x03) << 4) | (source[i + 1] >> 4)];
+        cursor[2] = base64Alphabet[(source[i + 1] & 0x0F) << 2];
+        cursor[3] = '=';
+        cursor += 4;
+    }
+
+    return cursor - output;
+}
+
+static std::optional<size_t> DecodeStrictScalar(const uint8_t* source, size_t length, uint8_t* output)
+{
+    if (length % 4 != 0) 
+    {
+        return std::nullopt;
+    }
+    if (length == 0) 
+    {
+        return 0;
+    }
+
+    const size_t padding = source[length - 1] != '=' ? 0 : source[length - 2] != '=' ? 1 : 2;
+    const size_t fullQuads = (length / 4) - (padding ? 1 : 0);
+    uint8_t* cursor = output;
+
+    for (size_t quad = 0; quad < fullQuads; quad++, source += 4, cursor += 3) 
+    {
+        const uint8_t a = base64DecodeTable[source[0]], b = base64DecodeTable[source[1]];
+        const uint8_t c = base64DecodeTable[source[2]], d = base64DecodeTable[source[3]];
+
+        if ((a | b | c | d) & 0xC0) 
+        {
+            return std::nullopt;
+        }
+
+        cursor[0] = uint8_t((a << 2) | (b >> 4));
+        cursor[1] = uint8_t((b << 4) | (c >> 2));
+        cursor[2] = uint8_t((c << 6) | d);
+    }
+
+    if (padding) 
+    {
+        const uint8_t a = base64DecodeTable[source[0]], b = base64DecodeTable[source[1]];
+        const uint8_t c = padding == 1 ? base64DecodeTable[source[2]] : 0;
+
+        /** Unused trailing bits must be zero for the encoding to be canonical. */
+        if (((a | b | c) & 0xC0) || (padding == 2 && (b & 0x0F)) || (padding == 1 && (c & 0x03))) 
+        {
+            return std::nullopt;
+        }
+
+        *cursor++ = uint8_t((a << 2) | (b >> 4));
+        if (padding == 1) *cursor++ = uint8_t((b << 4) | (c >> 2));
+    }
+
+    return cursor - output;
+}
+
+static size_t DecodeLenientScalar(const uint8_t* source, size_t length, uint8_t* output)
+{
+    uint8_t* cursor = output;
+    size_t i = 0;
+
+    /** Fast path for whole quads, falls through to the bit accumulator once anything unusual shows up. */
+    for (; i + 4 <= length; i += 4, cursor += 3) 
+    {
+        const uint8_t a = base64DecodeTable[source[i]],     b = base64DecodeTable[source[i + 1]];
+        const uint8_t c = base64DecodeTable[source[i + 2]], d = base64DecodeTable[source[i + 3]];
+
+        if ((a | b | c | d) & 0xC0) 
+            break;
+
+        cursor[0] = uint8_t((a << 2) | (b >> 4));
+        cursor[1] = uint8_t((b << 4) | (c >> 2));
+        cursor[2] = uint8_t((c << 6) | d);
+    }
+
+    uint32_t accumulator = 0;
+    int bitCount = 0;
+
+    for (; i < length; i++) 
+    {
+        const uint8_t character = source[i];
+        const uint8_t value = base64DecodeTable[character];
+
+        if (value == invalidCharacter) 
+        {
+            if (character == ' ' || character == '\t' || character == '\r' || character == '\n') 
+                continue;
+
+            break;
+        }
+
+        accumulator = (accumulator << 6) | value;
+        bitCount += 6;
+
+        if (bitCount >= 8) 
+        {
+            bitCount -= 8;
+            *cursor++ = uint8_t(accumulator >> bitCount);
+        }
+    }
+
+    return cursor - output;
+}
+
+#ifdef MILLENNIUM_BASE64_X86
+/**
+ * Kernels based on Wojciech Muła's pshufb base64 codec. 
+ * http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html 
+ * http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+ */
+MILLENNIUM_TARGET("ssse3") static inline __m128i UnpackSSSE3(__m128i input)
+{
+    const __m128i in = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    const __m128i low = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+
+    return _mm_or_si128(high, low);
+}
+
+MILLENNIUM_TARGET("ssse3") static inline __m128i LookupSSSE3(__m128i indices)
+{
+    const __m128i shiftTable = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, 
+                                             '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    result = _mm_or_si128(result, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+
+    return _mm_add_epi8(_mm_shuffle_epi8(shiftTable, result), indices);
+}
+
+MILLENNIUM_TARGET("ssse3") static size_t EncodeSSSE3(const uint8_t* source, size_t length, char* output)
+{
+    size_t i = 0;
+
+    /** Each block loads 16 bytes but only consumes 12 of them. */
+    for (; i + 16 <= length; i += 12, output += 16) 
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), LookupSSSE3(UnpackSSSE3(input)));
+    }
+    return i;
+}
+
+MILLENNIUM_TARGET("ssse3") static size_t DecodeSSSE3(const char* source, size_t length, uint8_t* output)
+{
+    const __m128i shiftTable  = _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i maskTable   = _mm_setr_epi8((char)0xA8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, 
+                                              (char)0xF8, (char)0xF8, (char)0xF0, 0x54, 0x50, 0x50, 0x50, 0x54);
+    const __m128i bitTable    = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i packShuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t i = 0;
+
+    /** Stores write 16 bytes for 12 decoded ones, keep a block of slack so the output buffer is never overrun. */
+    for (; i + 24 <= length; i += 16, output += 12) 
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        const __m128i highNibble = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0F));
+        const __m128i lowNibble = _mm_and_si128(input, _mm_set1_epi8(0x0F));
+
+        const __m128i valid = _mm_and_si128(_mm_shuffle_epi8(maskTable, lowNibble), _mm_shuffle_epi8(bitTable, highNibble));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128()))) 
+            break;
+
+        /** '/' shares its high nibble with '+', correct its shift from 19 down to 16. */
+        const __m128i shift = _mm_add_epi8(_mm_shuffle_epi8(shiftTable, highNibble), _mm_and_si128(_mm_cmpeq_epi8(input, _mm_set1_epi8('/')), _mm_set1_epi8(-3)));
+        const __m128i values = _mm_add_epi8(input, shift);
+
+        const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_shuffle_epi8(merged, packShuffle));
+    }
+    return i;
+}
+
+MILLENNIUM_TARGET("avx2") static size_t EncodeAVX2(const uint8_t* source, size_t length, char* output)
+{
+    const __m256i unpackShuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 
+                                                   1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i shiftTable = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, 
+                                                '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, 
+                                                '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+
+    /** Each 128 bit lane is fed 12 bytes, the upper lane's load reads 4 bytes past the block. */
+    for (; i + 28 <= length; i += 24, output += 32) 
+    {
+        const __m128i lowLane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        const __m128i highLane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 12));
+        const __m256i in = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lowLane), highLane, 1), unpackShuffle);
+
+        const __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        const __m256i low = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(high, low);
+
+        __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        result = _mm256_or_si256(result, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+        result = _mm256_add_epi8(_mm256_shuffle_epi8(shiftTable, result), indices);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), result);
+    }
+    return i;
+}
+
+MILLENNIUM_TARGET("avx2") static size_t DecodeAVX2(const char* source, size_t length, uint8_t* output)
+{
+    const __m256i shiftTable = _mm256_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i maskTable = _mm256_setr_epi8((char)0xA8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, 
+                                               (char)0xF8, (char)0xF8, (char)0xF0, 0x54, 0x50, 0x50, 0x50, 0x54,
+                                               (char)0xA8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, (char)0xF8, 
+                                               (char)0xF8, (char)0xF8, (char)0xF0, 0x54, 0x50, 0x50, 0x50, 0x54);
+    const __m256i bitTable = _mm256_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i packShuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i packLanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    size_t i = 0;
+
+    /** Stores write 32 bytes for 24 decoded ones, keep a block of slack so the output buffer is never overrun. */
+    for (; i + 48 <= length; i += 32, output += 24) 
+    {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        const __m256i highNibble = _mm256_and_si256(_mm256_srli_epi32(input, 4), _mm256_set1_epi8(0x0F));
+        const __m256i lowNibble = _mm256_and_si256(input, _mm256_set1_epi8(0x0F));
+
+        const __m256i valid = _mm256_and_si256(_mm256_shuffle_epi8(maskTable, lowNibble), _mm256_shuffle_epi8(bitTable, highNibble));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(valid, _mm256_setzero_si256()))) 
+            break;
+
+        const __m256i shift = _mm256_add_epi8(_mm256_shuffle_epi8(shiftTable, highNibble), _mm256_and_si256(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('/')), _mm256_set1_epi8(-3)));
+        const __m256i values = _mm256_add_epi8(input, shift);
+
+        const __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, packShuffle), packLanes);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), packed);
+    }
+    return i;
+}
+#endif
+
+#ifdef MILLENNIUM_BASE64_NEON
+static size_t EncodeNEON(const uint8_t* source, size_t length, char* output)
+{
+    const uint8_t* alphabet = reinterpret_cast<const uint8_t*>(base64Alphabet);
+    const uint8x16x4_t table = {{ vld1q_u8(alphabet), vld1q_u8(alphabet + 16), vld1q_u8(alphabet + 32), vld1q_u8(alphabet + 48) }};
+    const uint8x16_t sextetMask = vdupq_n_u8(0x3F);
+
+    size_t i = 0;
+
+    for (; i + 48 <= length; i += 48, output += 64) 
+    {
+        const uint8x16x3_t in = vld3q_u8(source + i);
+        uint8x16x4_t out;
+
+        out.val[0] = vqtbl4q_u8(table, vshrq_n_u8(in.val[0], 2));
+        out.val[1] = vqtbl4q_u8(table, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), sextetMask));
+        out.val[2] = vqtbl4q_u8(table, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), sextetMask));
+        out.val[3] = vqtbl4q_u8(table, vandq_u8(in.val[2], sextetMask));
+
+        vst4q_u8(reinterpret_cast<uint8_t*>(output), out);
+    }
+    return i;
+}
+
+static size_t DecodeNEON(const char* source, size_t length, uint8_t* output)
+{
+    const uint8_t* decodeTable = base64DecodeTable.data();
+    const uint8x16x4_t lowTable  = {{ vld1q_u8(decodeTable),      vld1q_u8(decodeTable + 16), vld1q_u8(decodeTable + 32), vld1q_u8(decodeTable + 48) }};
+    const uint8x16x4_t highTable = {{ vld1q_u8(decodeTable + 64), vld1q_u8(decodeTable + 80), vld1q_u8(decodeTable + 96), vld1q_u8(decodeTable + 112) }};
+
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64, output += 48) 
+    {
+        const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(source + i));
+        uint8x16_t values[4];
+        uint8x16_t invalid = vdupq_n_u8(0);
+
+        for (int lane = 0; lane < 4; lane++) 
+        {
+            values[lane] = vqtbx4q_u8(vqtbl4q_u8(lowTable, in.val[lane]), highTable, vsubq_u8(in.val[lane], vdupq_n_u8(64)));
+            /** Invalid table entries and non ASCII input both carry the high bit. */
+            invalid = vorrq_u8(invalid, vorrq_u8(values[lane], in.val[lane]));
+        }
+
+        if (vmaxvq_u8(invalid) & 0x80) 
+            break;
+
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+
+        vst3q_u8(output, out);
+    }
+    return i;
+}
+#endif
+
+struct Base64Kernels 
+{
+    const char* name;
+    EncodeKernel encode;
+    DecodeKernel decode;
+};
+
+static const Base64Kernels& GetKernels()
+{
+    static const Base64Kernels kernels = []() -> Base64Kernels 
+    {
+#if defined(MILLENNIUM_BASE64_X86)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))  return { "avx2",  EncodeAVX2,  DecodeAVX2  };
+        if (__builtin_cpu_supports("ssse3")) return { "ssse3", EncodeSSSE3, DecodeSSSE3 };
+#elif defined(MILLENNIUM_BASE64_NEON)
+        return { "neon", EncodeNEON, DecodeNEON };
+#endif
+        return { "scalar", nullptr, nullptr };
+    }();
+
+    return kernels;
+}
+
+MILLENNIUM size_t Base64::EncodedLength(size_t length)
+{
+    return (length + 2) / 3 * 4;
+}
+
+MILLENNIUM size_t Base64::MaxDecodedLength(size_t length)
+{
+    return (length + 3) / 4 * 3;
+}
+
+MILLENNIUM size_t Base64::EncodeInto(const void* data, size_t length, char* output)
+{
+    const uint8_t* source = static_cast<const uint8_t*>(data);
+    const Base64Kernels& kernels = GetKernels();
+
+    size_t consumed = kernels.encode ? kernels.encode(source, length, output) : 0;
+    size_t written = consumed / 3 * 4;
+
+    return written + EncodeScalar(source + consumed, length - consumed, output + written);
+}
+
+MILLENNIUM std::optional<size_t> Base64::DecodeInto(const char* data, size_t length, void* output, DecodeMode mode)
+{
+    uint8_t* destination = static_cast<uint8_t*>(output);
+    const Base64Kernels& kernels = GetKernels();
+
+    size_t consumed = kernels.decode ? kernels.decode(data, length, destination) : 0;
+    size_t written = consumed / 4 * 3;
+
+    const uint8_t* remaining = reinterpret_cast<const uint8_t*>(data) + consumed;
+
+    if (mode == DecodeMode::Strict) 
+    {
+        const auto tail = DecodeStrictScalar(remaining, length - consumed, destination + written);
+        return tail ? std::optional<size_t>(written + *tail) : std::nullopt;
+    }
+
+    return written + DecodeLenientScalar(remaining, length - consumed, destination + written);
+}
+
+MILLENNIUM const char* Base64::GetKernelName()
+{
+    return GetKernels().name;
+}
+
+MILLENNIUM std::string Base64Encode(const std::string& in)
+{
+    std::string encoded(Base64::EncodedLength(in.size()), '\0');
+    Base64::EncodeInto(in.data(), in.size(), &encoded[0]);
+    return encoded;
+}
+
+MILLENNIUM std::string Base64Encode(const std::vector<char>& data)
+{
+    std::string encoded(Base64::EncodedLength(data.size()), '\0');
+    Base64::EncodeInto(data.data(), data.size(), &encoded[0]);
+    return encoded;
+}
+
+MILLENNIUM std::string Base64Decode(const std::string& in)
+{
+    std::string decoded(Base64::MaxDecodedLength(in.size()), '\0');
+    decoded.resize(Base64::DecodeInto(in.data(), in.size(), &decoded[0], Base64::DecodeMode::Lenient).value_or(0));
+    return decoded;
+}
+
+MILLENNIUM std::optional<std::string> Base64DecodeStrict(const std::string& in)
+{
+    std::string decoded(Base64::MaxDecodedLength(in.size()), '\0');
+    const auto decodedLength = Base64::DecodeInto(in.data(), in.size(), &decoded[0], Base64::DecodeMode::Strict);
+
+    if (!decodedLength) 
+    {
+        return std::nullopt;
+    }
+
+    decoded.resize(*decodedLength);
+    return decoded;
+}
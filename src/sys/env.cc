@@ -135,11 +135,14 @@ const void SetupEnvironmentVariables()
         { "MILLENNIUM__PLUGINS_PATH",   SystemIO::GetInstallPath().string() + "/plugins" },
         { "MILLENNIUM__CONFIG_PATH",    SystemIO::GetInstallPath().string() + "/ext" },
         { "MILLENNIUM__LOGS_PATH",      SystemIO::GetInstallPath().string() + "/ext/logs" },
+        { "MILLENNIUM__CACHE_PATH",     SystemIO::GetInstallPath().string() + "/ext/cache" },
         { "MILLENNIUM__DATA_LIB",       dataLibPath },
         { "MILLENNIUM__PYTHON_ENV",     SystemIO::GetInstallPath().string() + "/ext/data/cache" },
         { "MILLENNIUM__SHIMS_PATH",     shimsPath },
         { "MILLENNIUM__ASSETS_PATH",    assetsPath },
-        { "MILLENNIUM__INSTALL_PATH",   SystemIO::GetInstallPath().string() }
+        { "MILLENNIUM__INSTALL_PATH",   SystemIO::GetInstallPath().string() },
+        /** Next to the Python runtime it links, and away from the user32 proxy in Steam's directory. */
+        { "MILLENNIUM__BACKEND_WORKER_PATH", SystemIO::GetInstallPath().string() + "/ext/data/cache/millennium_worker.exe" }
     };
     environment.insert(environment_windows.begin(), environment_windows.end());
     #elif __linux__
@@ -147,6 +150,7 @@ const void SetupEnvironmentVariables()
     const std::string configDir = GetEnvWithFallback("XDG_CONFIG_HOME", fmt::format("{}/.config", homeDir));
     const std::string dataDir   = GetEnvWithFallback("XDG_DATA_HOME", fmt::format("{}/.local/share", homeDir));
     const std::string stateDir  = GetEnvWithFallback("XDG_STATE_HOME", fmt::format("{}/.local/state", homeDir));
+    const std::string cacheDir  = GetEnvWithFallback("XDG_CACHE_HOME", fmt::format("{}/.cache", homeDir));
     const static std::string pythonEnv = fmt::format("{}/millennium/.venv", dataDir);
     const std::string pythonEnvBin = fmt::format("{}/bin/python3.11", pythonEnv);
 
@@ -156,12 +160,14 @@ const void SetupEnvironmentVariables()
   
     std::map<std::string, std::string> environment_unix = {
         { "MILLENNIUM_RUNTIME_PATH", "/usr/lib/millennium/libmillennium_x86.so" },
+        { "MILLENNIUM__BACKEND_WORKER_PATH", "/usr/lib/millennium/millennium_worker" },
         { "LIBPYTHON_RUNTIME_PATH",  LIBPYTHON_RUNTIME_PATH },
 
         { "MILLENNIUM__STEAM_EXE_PATH", fmt::format("{}/.steam/steam/ubuntu12_32/steam",     homeDir) },
         { "MILLENNIUM__PLUGINS_PATH",   fmt::format("{}/millennium/plugins",    dataDir) },
         { "MILLENNIUM__CONFIG_PATH",    fmt::format("{}/millennium",            configDir) },
         { "MILLENNIUM__LOGS_PATH",      fmt::format("{}/millennium/logs",       stateDir) },
+        { "MILLENNIUM__CACHE_PATH",     fmt::format("{}/millennium",            cacheDir) },
         { "MILLENNIUM__DATA_LIB",       dataLibPath },
         { "MILLENNIUM__SHIMS_PATH",     shimsPath },
         { "MILLENNIUM__ASSETS_PATH",    assetsPath },
@@ -179,6 +185,7 @@ const void SetupEnvironmentVariables()
     const std::string configDir = fmt::format("{}/Library/Application Support", homeDir);
     const std::string dataDir   = fmt::format("{}/Library/Application Support", homeDir);
     const std::string stateDir  = fmt::format("{}/Library/Logs", homeDir);
+    const std::string cacheDir  = fmt::format("{}/Library/Caches", homeDir);
     const static std::string pythonEnv = fmt::format("{}/millennium/.venv", dataDir);
     const std::string pythonEnvBin = fmt::format("{}/bin/python3.11", pythonEnv);
 
@@ -188,12 +195,14 @@ const void SetupEnvironmentVariables()
   
     std::map<std::string, std::string> environment_macos = {
         { "MILLENNIUM_RUNTIME_PATH", "/usr/local/lib/millennium/libmillennium_x86.dylib" },
+        { "MILLENNIUM__BACKEND_WORKER_PATH", "/usr/local/lib/millennium/millennium_worker" },
         { "LIBPYTHON_RUNTIME_PATH",  LIBPYTHON_RUNTIME_PATH },
 
         { "MILLENNIUM__STEAM_EXE_PATH", fmt::format("{}/Library/Application Support/Steam/Steam.app/Contents/MacOS/steam_osx", homeDir) },
         { "MILLENNIUM__PLUGINS_PATH",   fmt::format("{}/millennium/plugins",    dataDir) },
         { "MILLENNIUM__CONFIG_PATH",    fmt::format("{}/millennium",            configDir) },
         { "MILLENNIUM__LOGS_PATH",      fmt::format("{}/millennium",            stateDir) },
+        { "MILLENNIUM__CACHE_PATH",     fmt::format("{}/millennium",            cacheDir) },
         { "MILLENNIUM__DATA_LIB",       dataLibPath },
         { "MILLENNIUM__SHIMS_PATH",     shimsPath },
         { "MILLENNIUM__ASSETS_PATH",    assetsPath },
@@ -0,0 +1,641 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * main.cc
+ *
+ * millennium_worker, hosts a single plugin backend outside of Steam's process. It is started and supervised by 
+ * Millennium (see BackendWorker), and talks to it over the ShmChannel it inherited.
+ *
+ * The plugin runs in this process' own main interpreter. Its `Millennium` and `PluginUtils` modules are stand-ins 
+ * that forward to Millennium, everything else it imports is loaded here.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "shm_ring.h"
+#ifdef _WIN32
+#include <shellapi.h>
+#endif
+
+struct WorkerOptions
+{
+    std::string pluginName;
+    std::string mainModule;
+    std::string baseDirectory;
+    std::string fileName;
+    std::string pythonHome;
+    std::string sitePackages;
+    std::string pycachePrefix;
+    std::vector<std::string> modulePaths;
+    size_t ringSize = 0;
+    std::vector<ShmHandle> channelHandles;
+};
+
+static std::unique_ptr<ShmChannel> g_channel;
+static std::atomic<bool> g_exiting { false };
+
+/** Requests from Millennium (invoke, frontend_loaded, unload) and results of API calls, filled by the reader thread. */
+static std::mutex g_messageMutex;
+static std::condition_variable g_messageCondition;
+static std::deque<std::string> g_requests;
+static std::unordered_map<uint64_t, std::string> g_apiResults;
+
+/** The thread running serve(), only it handles requests, i.e while it waits on an API call of its own. */
+static std::thread::id g_dispatcherThread;
+static PyObject* g_requestHandler = nullptr;
+static bool g_unloaded = false;
+
+/**
+ * The Python side of the worker, run once the interpreter is up. 
+ * `_options` holds the parsed command line, `_worker` the native module below.
+ */
+static const char* g_bootstrapSource = R"PY(
+import builtins, itertools, json, os, site, sys, traceback, types
+
+_call_ids = itertools.count()
+_main = sys.modules["__main__"].__dict__
+
+def _send(message):
+    _worker.send(json.dumps(message))
+
+def _call_millennium(method, args, kwargs):
+    call_id = next(_call_ids)
+    response = json.loads(_worker.call(call_id, json.dumps({ "type": "api", "id": call_id, "method": method, "args": list(args), "kwargs": kwargs })))
+
+    if not response.get("ok"):
+        raise RuntimeError(response.get("error", "Millennium API call failed"))
+    return response.get("value")
+
+def _millennium_getattr(name):
+    if name.startswith("__") and name.endswith("__"):
+        raise AttributeError(name)
+
+    def forward(*args, **kwargs):
+        return _call_millennium(name, args, kwargs)
+
+    forward.__name__ = name
+    return forward
+
+class Logger:
+    def __init__(self, *args, **kwargs):
+        pass
+    def log(self, message):
+        _send({ "type": "logger", "level": "log", "message": str(message) })
+    def warn(self, message):
+        _send({ "type": "logger", "level": "warn", "message": str(message) })
+    def error(self, message):
+        _send({ "type": "logger", "level": "error", "message": str(message) })
+
+class _Output:
+    def __init__(self, stream):
+        self._stream = stream
+    def write(self, text):
+        if text:
+            _send({ "type": "output", "stream": self._stream, "message": text })
+        return len(text)
+    def flush(self):
+        pass
+    def isatty(self):
+        return False
+
+millennium = types.ModuleType("Millennium")
+millennium.__getattr__ = _millennium_getattr
+sys.modules["Millennium"] = millennium
+
+plugin_utils = types.ModuleType("PluginUtils")
+plugin_utils.Logger = Logger
+sys.modules["PluginUtils"] = plugin_utils
+
+sys.stdout = _Output("stdout")
+sys.stderr = _Output("stderr")
+
+_main["MILLENNIUM_PLUGIN_SECRET_NAME"] = _options["plugin_name"]
+_main["PLUGIN_BASE_DIR"] = _options["base_directory"]
+_main["__file__"] = _options["file_name"]
+builtins.MILLENNIUM_PLUGIN_SECRET_NAME = _options["plugin_name"]
+
+sys.path.append(os.path.dirname(_options["main_module"]))
+site.addsitedir(_options["site_packages"])
+
+# Mirrors PyObjectCastEvalResult, the frontend gets the same results whether a backend runs in or out of process.
+BOOLEAN, STRING, JSON, INTEGER, ERROR, UNKNOWN = range(6)
+
+def _cast_result(value):
+    if isinstance(value, bool):
+        return BOOLEAN, "True" if value else "False"
+    if isinstance(value, int):
+        if not -2**31 <= value < 2**31:
+            return ERROR, "Integer overflow or conversion error"
+        return INTEGER, str(value)
+    if isinstance(value, float):
+        return STRING, "%f" % value
+    if isinstance(value, str):
+        return STRING, value
+    if isinstance(value, bytes):
+        return STRING, value.decode("utf-8", "replace")
+    if isinstance(value, (list, tuple, dict)):
+        try:
+            return JSON, json.dumps(value, ensure_ascii=False, separators=(",", ":"))
+        except (TypeError, ValueError):
+            return JSON, repr(value)
+    if value is None:
+        return JSON, "null"
+    return UNKNOWN, repr(value)
+
+def _invoke(call):
+    try:
+        names = call["methodName"].split(".")
+        function = _main[names[0]]
+        for name in names[1:]:
+            function = getattr(function, name)
+        return_type, plain = _cast_result(function(**(call.get("argumentList") or {})))
+    except Exception as error:
+        return_type, plain = ERROR, str(error) + "".join(traceback.format_exception(error))
+    return { "returnType": return_type, "plain": plain }
+
+def _handle(request):
+    message = json.loads(request)
+    kind = message.get("type")
+    plugin = _main.get("plugin")
+
+    if kind == "invoke":
+        _send({ "type": "invoke_result", "id": message["id"], **_invoke(message["call"]) })
+    elif kind == "frontend_loaded" and plugin is not None:
+        try:
+            plugin._front_end_loaded()
+        except Exception:
+            print("Failed to call _front_end_loaded:\n" + traceback.format_exc(), file=sys.stderr)
+    elif kind == "unload":
+        if plugin is not None:
+            try:
+                plugin._unload()
+            except Exception:
+                print("'{}' refused to shutdown properly:\n{}".format(_options["plugin_name"], traceback.format_exc()), file=sys.stderr)
+        return False
+    return True
+
+def _load():
+    try:
+        with open(_options["main_module"], "rb") as main_module:
+            exec(compile(main_module.read(), _options["main_module"], "exec"), _main)
+    except BaseException:
+        _send({ "type": "load_failed", "message": traceback.format_exc() })
+        return False
+
+    if not hasattr(builtins, "__millennium_plugin_settings_parser__"):
+        builtins.__millennium_plugin_settings_parser__ = lambda: False
+
+    try:
+        plugin = _main["Plugin"]()
+        _main["plugin"] = plugin
+        plugin._load()
+    except Exception:
+        print("Millennium failed to call _load on {}:\n{}".format(_options["plugin_name"], traceback.format_exc()), file=sys.stderr)
+    return True
+
+_worker.serve(_handle, _load)
+)PY";
+
+/**
+ * @brief Route messages from Millennium until the worker exits, API results go straight to the thread waiting on them.
+ */
+static void ReadMessages()
+{
+    std::string message;
+
+    while (!g_exiting.load()) 
+    {
+        if (!g_channel->Receive(message, std::chrono::milliseconds(250))) 
+        {
+            /** Nothing can be trusted from the channel anymore, and Python may be blocked on it, so leave right away. */
+            if (g_channel->IsBroken()) 
+            {
+                std::cerr << "millennium_worker: Millennium's channel is corrupt, exiting." << std::endl;
+                std::_Exit(3);
+            }
+            continue;
+        }
+
+        const nlohmann::json parsed = nlohmann::json::parse(message, nullptr, false);
+        if (!parsed.is_object()) 
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(g_messageMutex);
+
+        if (parsed.value("type", std::string()) == "api_result") 
+        {
+            g_apiResults[parsed.value("id", 0ull)] = std::move(message);
+        }
+        else 
+        {
+            g_requests.push_back(std::move(message));
+        }
+        g_messageCondition.notify_all();
+    }
+}
+
+/**
+ * @brief Pass a request to the handler given to serve(), with the GIL held.
+ */
+static void RunRequest(const std::string& request)
+{
+    PyObject* result = PyObject_CallFunction(g_requestHandler, "s#", request.data(), static_cast<Py_ssize_t>(request.size()));
+
+    if (!result) 
+    {
+        PyErr_Print();
+        return;
+    }
+
+    if (result == Py_False) 
+    {
+        g_unloaded = true;
+    }
+    Py_DECREF(result);
+}
+
+/**
+ * @brief send(message) - Send a message to Millennium.
+ */
+static PyObject* WorkerSend(PyObject* self, PyObject* args)
+{
+    const char* message;
+    Py_ssize_t length;
+
+    if (!PyArg_ParseTuple(args, "s#", &message, &length)) 
+    {
+        return NULL;
+    }
+
+    bool sent;
+    Py_BEGIN_ALLOW_THREADS
+    sent = g_channel->Send(std::string_view(message, static_cast<size_t>(length)));
+    Py_END_ALLOW_THREADS
+
+    return PyBool_FromLong(sent);
+}
+
+/**
+ * @brief call(call_id, message) - Send an API call to Millennium and wait for its api_result.
+ * 
+ * Millennium may call back into the plugin before it answers, i.e when the API call waits on the frontend, 
+ * so the dispatcher thread keeps handling requests while it waits.
+ */
+static PyObject* WorkerCall(PyObject* self, PyObject* args)
+{
+    unsigned long long callId;
+    const char* message;
+    Py_ssize_t length;
+
+    if (!PyArg_ParseTuple(args, "Ks#", &callId, &message, &length)) 
+    {
+        return NULL;
+    }
+
+    const bool isDispatcher = std::this_thread::get_id() == g_dispatcherThread;
+    std::string result;
+
+    PyThreadState* threadState = PyEval_SaveThread();
+
+    if (!g_channel->Send(std::string_view(message, static_cast<size_t>(length)))) 
+    {
+        PyEval_RestoreThread(threadState);
+        PyErr_SetString(PyExc_RuntimeError, "couldn't reach Millennium, the call is too large or Millennium stopped responding");
+        return NULL;
+    }
+
+    std::unique_lock<std::mutex> lock(g_messageMutex);
+
+    while (true) 
+    {
+        g_messageCondition.wait(lock, [&] { return g_apiResults.count(callId) || (isDispatcher && !g_requests.empty()); });
+
+        auto apiResult = g_apiResults.find(callId);
+        if (apiResult != g_apiResults.end()) 
+        {
+            result = std::move(apiResult->second);
+            g_apiResults.erase(apiResult);
+            break;
+        }
+
+        std::string request = std::move(g_requests.front());
+        g_requests.pop_front();
+
+        lock.unlock();
+        PyEval_RestoreThread(threadState);
+
+        RunRequest(request);
+
+        threadState = PyEval_SaveThread();
+        lock.lock();
+    }
+
+    lock.unlock();
+    PyEval_RestoreThread(threadState);
+
+    return PyUnicode_FromStringAndSize(result.data(), static_cast<Py_ssize_t>(result.size()));
+}
+
+/**
+ * @brief serve(handler, setup) - Handle requests from Millennium on the calling thread until the plugin is unloaded.
+ * 
+ * handler(request) is called for every request, and returns False once the worker should exit. setup() runs first, 
+ * requests that arrive while it waits on an API call are already handled, and nothing is served if it returns False.
+ */
+static PyObject* WorkerServe(PyObject* self, PyObject* args)
+{
+    PyObject* handler;
+    PyObject* setup;
+
+    if (!PyArg_ParseTuple(args, "OO", &handler, &setup)) 
+    {
+        return NULL;
+    }
+
+    Py_XSETREF(g_requestHandler, Py_NewRef(handler));
+    g_dispatcherThread = std::this_thread::get_id();
+
+    PyObject* setupResult = PyObject_CallNoArgs(setup);
+
+    if (!setupResult) 
+    {
+        Py_CLEAR(g_requestHandler);
+        return NULL;
+    }
+
+    g_unloaded = g_unloaded || setupResult == Py_False;
+    Py_DECREF(setupResult);
+
+    while (!g_unloaded) 
+    {
+        std::string request;
+
+        Py_BEGIN_ALLOW_THREADS
+        {
+            std::unique_lock<std::mutex> lock(g_messageMutex);
+            g_messageCondition.wait(lock, [] { return !g_requests.empty(); });
+
+            request = std::move(g_requests.front());
+            g_requests.pop_front();
+        }
+        Py_END_ALLOW_THREADS
+
+        RunRequest(request);
+    }
+
+    Py_CLEAR(g_requestHandler);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef g_workerMethods[] = 
+{
+    { "send",  WorkerSend,  METH_VARARGS, NULL },
+    { "call",  WorkerCall,  METH_VARARGS, NULL },
+    { "serve", WorkerServe, METH_VARARGS, NULL },
+    { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef g_workerModuleDef = 
+{
+    PyModuleDef_HEAD_INIT,
+    "_millennium_worker",
+    NULL,
+    -1,
+    g_workerMethods
+};
+
+static PyObject* PyInit_MillenniumWorker()
+{
+    return PyModule_Create(&g_workerModuleDef);
+}
+
+/**
+ * @brief Get the command line as UTF-8, on Windows the narrow argv is in the ANSI code page.
+ */
+static std::vector<std::string> GetArguments(int argc, char** argv)
+{
+    #ifdef _WIN32
+    {
+        int count = 0;
+        LPWSTR* wideArguments = CommandLineToArgvW(GetCommandLineW(), &count);
+        std::vector<std::string> arguments;
+
+        for (int i = 0; i < count; i++) 
+        {
+            const int size = WideCharToMultiByte(CP_UTF8, 0, wideArguments[i], -1, nullptr, 0, nullptr, nullptr);
+            std::string argument(size > 0 ? size - 1 : 0, '\0');
+
+            WideCharToMultiByte(CP_UTF8, 0, wideArguments[i], -1, argument.data(), size, nullptr, nullptr);
+            arguments.push_back(std::move(argument));
+        }
+
+        LocalFree(wideArguments);
+        return arguments;
+    }
+    #else
+    {
+        return std::vector<std::string>(argv, argv + argc);
+    }
+    #endif
+}
+
+static std::optional<WorkerOptions> ParseOptions(const std::vector<std::string>& arguments)
+{
+    WorkerOptions options;
+
+    for (size_t i = 1; i + 1 < arguments.size(); i += 2) 
+    {
+        const std::string& name  = arguments[i];
+        const std::string& value = arguments[i + 1];
+
+        if      (name == "--plugin")        options.pluginName = value;
+        else if (name == "--main")          options.mainModule = value;
+        else if (name == "--base")          options.baseDirectory = value;
+        else if (name == "--file")          options.fileName = value;
+        else if (name == "--home")          options.pythonHome = value;
+        else if (name == "--module-path")   options.modulePaths.push_back(value);
+        else if (name == "--site-packages") options.sitePackages = value;
+        else if (name == "--pycache")       options.pycachePrefix = value;
+        else if (name == "--ring-size")     options.ringSize = std::stoul(value);
+        else if (name == "--channel") 
+        {
+            size_t start = 0;
+
+            while (start <= value.size()) 
+            {
+                const size_t end = std::min(value.find(',', start), value.size());
+                const unsigned long long handle = std::stoull(value.substr(start, end - start));
+
+                #ifdef _WIN32
+                options.channelHandles.push_back(reinterpret_cast<HANDLE>(static_cast<uintptr_t>(handle)));
+                #else
+                options.channelHandles.push_back(static_cast<int>(handle));
+                #endif
+                start = end + 1;
+            }
+        }
+    }
+
+    if (options.pluginName.empty() || options.mainModule.empty() || options.ringSize == 0 || options.channelHandles.size() != ShmChannel::HANDLE_COUNT) 
+    {
+        return std::nullopt;
+    }
+    return options;
+}
+
+/**
+ * @brief Start Python the same way Millennium does in Steam (see PythonManager).
+ */
+static bool InitializePython(const WorkerOptions& options)
+{
+    PyImport_AppendInittab("_millennium_worker", &PyInit_MillenniumWorker);
+
+    PyConfig config;
+    PyConfig_InitPythonConfig(&config);
+
+    PyStatus status = PyConfig_Read(&config);
+
+    if (!PyStatus_Exception(status)) 
+    {
+        PyConfig_SetString(&config, &config.home, std::wstring(options.pythonHome.begin(), options.pythonHome.end()).c_str());
+        config.module_search_paths_set = 1;
+
+        /** Shares the bytecode cache with in process backends, without one nothing is written. */
+        if (!options.pycachePrefix.empty()) 
+        {
+            PyConfig_SetString(&config, &config.pycache_prefix, std::wstring(options.pycachePrefix.begin(), options.pycachePrefix.end()).c_str());
+        }
+        config.write_bytecode = options.pycachePrefix.empty() ? 0 : 1;
+
+        for (const std::string& modulePath : options.modulePaths) 
+        {
+            PyWideStringList_Append(&config.module_search_paths, std::wstring(modulePath.begin(), modulePath.end()).c_str());
+        }
+
+        status = Py_InitializeFromConfig(&config);
+    }
+
+    PyConfig_Clear(&config);
+
+    if (PyStatus_Exception(status)) 
+    {
+        std::cerr << "millennium_worker: couldn't initialize Python: " << (status.err_msg ? status.err_msg : "unknown") << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Run the bootstrap, which loads the plugin and serves it until it is unloaded.
+ * @returns {int} - The process exit code.
+ */
+static int RunBootstrap(const WorkerOptions& options)
+{
+    PyObject* globals = PyDict_New();
+    PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+
+    PyObject* workerModule = PyImport_ImportModule("_millennium_worker");
+    PyObject* optionsDict = Py_BuildValue("{s:s,s:s,s:s,s:s,s:s}", 
+        "plugin_name",    options.pluginName.c_str(), 
+        "main_module",    options.mainModule.c_str(), 
+        "base_directory", options.baseDirectory.c_str(), 
+        "file_name",      options.fileName.c_str(), 
+        "site_packages",  options.sitePackages.c_str()
+    );
+
+    if (!workerModule || !optionsDict) 
+    {
+        PyErr_Print();
+        return 1;
+    }
+
+    PyDict_SetItemString(globals, "_worker", workerModule);
+    PyDict_SetItemString(globals, "_options", optionsDict);
+
+    PyObject* result = PyRun_String(g_bootstrapSource, Py_file_input, globals, globals);
+    const int exitCode = result ? 0 : 1;
+
+    if (!result) 
+    {
+        PyErr_Print();
+    }
+
+    Py_XDECREF(result);
+    Py_DECREF(optionsDict);
+    Py_DECREF(workerModule);
+    Py_DECREF(globals);
+    return exitCode;
+}
+
+int main(int argc, char** argv)
+{
+    const std::optional<WorkerOptions> options = ParseOptions(GetArguments(argc, argv));
+
+    if (!options.has_value()) 
+    {
+        std::cerr << "millennium_worker hosts plugin backends for Millennium, it isn't meant to be started by hand." << std::endl;
+        return 2;
+    }
+
+    g_channel = ShmChannel::Attach(options->channelHandles, options->ringSize);
+
+    if (!g_channel) 
+    {
+        std::cerr << "millennium_worker: couldn't attach to Millennium's channel." << std::endl;
+        return 2;
+    }
+
+    std::thread reader(ReadMessages);
+
+    int exitCode = 1;
+    if (InitializePython(*options)) 
+    {
+        exitCode = RunBootstrap(*options);
+        Py_FinalizeEx();
+    }
+
+    g_exiting.store(true);
+    reader.join();
+    return exitCode;
+}
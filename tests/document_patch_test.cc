@@ -0,0 +1,138 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <string>
+#include "http_hooks.h"
+#include "test_helpers.h"
+
+static const std::string DOCUMENT_URL = "https://store.steampowered.com/";
+static const std::string DOCUMENT = "<html><head><meta charset=\"utf-8\"></head><body><p>abcde</p></body></html>";
+
+class HttpHookManagerTest
+{
+public:
+    static std::string PatchDocumentContents(const std::string& document)
+    {
+        return HttpHookManager::get().PatchDocumentContents(DOCUMENT_URL, document);
+    }
+};
+
+/** Rules are registered in the order given, and removed again once the document is patched. */
+static std::string PatchWithRules(const std::vector<std::tuple<std::string, std::string, HttpHookManager::RewriteAction>>& rules)
+{
+    static unsigned long long ruleId = 1'000'000;
+    std::vector<unsigned long long> ruleIds;
+
+    for (const auto& [match, content, action] : rules) 
+    {
+        ruleIds.push_back(++ruleId);
+        HttpHookManager::get().AddRewriteRule({ std::regex(".*"), match, content, action, ruleIds.back() });
+    }
+
+    const std::string patched = HttpHookManagerTest::PatchDocumentContents(DOCUMENT);
+
+    for (const auto id : ruleIds) 
+    {
+        HttpHookManager::get().RemoveHook(id);
+    }
+    return patched;
+}
+
+static bool Contains(const std::string& patched, const std::string& text)
+{
+    return patched.find(text) != std::string::npos;
+}
+
+/** A replacement spanning the point Millennium's shim is injected at is skipped, the shim always makes it into the page. */
+static void TestRuleOverlappingShim()
+{
+    const std::string patched = PatchWithRules({ { "<head><meta", "<head><REPLACED", HttpHookManager::RewriteAction::REPLACE } });
+
+    CHECK(Contains(patched, "id=\"millennium-injected\""));
+    CHECK(Contains(patched, "<meta charset=\"utf-8\">"));
+    CHECK(!Contains(patched, "REPLACED"));
+}
+
+/** Edits next to the shim don't overlap it, they are applied after it. */
+static void TestRuleNextToShim()
+{
+    const std::string patched = PatchWithRules({ 
+        { "<head>", "AFTER_HEAD", HttpHookManager::RewriteAction::INSERT_AFTER },
+        { "<meta", "<META", HttpHookManager::RewriteAction::REPLACE } 
+    });
+
+    CHECK(Contains(patched, "id=\"millennium-injected\""));
+    CHECK(Contains(patched, "AFTER_HEAD<META charset"));
+    CHECK(patched.find("millennium-injected") < patched.find("AFTER_HEAD"));
+}
+
+/** Overlapping rules are resolved by the order they were registered in, wherever they are in the document. */
+static void TestOverlappingRules()
+{
+    const std::string laterRuleFirstInDocument = PatchWithRules({ 
+        { "bcd", "1", HttpHookManager::RewriteAction::REPLACE }, 
+        { "abc", "2", HttpHookManager::RewriteAction::REPLACE } 
+    });
+    CHECK(Contains(laterRuleFirstInDocument, "<p>a1e</p>"));
+
+    const std::string earlierRuleFirstInDocument = PatchWithRules({ 
+        { "abc", "2", HttpHookManager::RewriteAction::REPLACE }, 
+        { "bcd", "1", HttpHookManager::RewriteAction::REPLACE } 
+    });
+    CHECK(Contains(earlierRuleFirstInDocument, "<p>2de</p>"));
+
+    const std::string insertIntoReplacement = PatchWithRules({ 
+        { "abcde", "3", HttpHookManager::RewriteAction::REPLACE }, 
+        { "c", "4", HttpHookManager::RewriteAction::INSERT_BEFORE },
+        { "<p>", "5", HttpHookManager::RewriteAction::INSERT_AFTER } 
+    });
+    CHECK(Contains(insertIntoReplacement, "<p>53</p>"));
+}
+
+int main()
+{
+    /** PatchDocumentContents only needs the preload module to exist, its contents are never read. */
+    const auto shimsPath = std::filesystem::temp_directory_path() / "millennium-document-patch-test";
+    std::filesystem::create_directories(shimsPath);
+    std::ofstream(shimsPath / "millennium.js").close();
+    setenv("MILLENNIUM__SHIMS_PATH", shimsPath.string().c_str(), 1);
+
+    TestRuleOverlappingShim();
+    TestRuleNextToShim();
+    TestOverlappingRules();
+
+    std::filesystem::remove_all(shimsPath);
+    return TEST_RESULT();
+}
@@ -0,0 +1,128 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <Python.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include "ffi.h"
+#include "plugin_executor.h"
+#include "test_helpers.h"
+
+static const char* PLUGIN_NAME = "frontend_future_test";
+
+/** Set once the frontend call was made, its frontend never loaded so it waits in DeferredFrontendCalls. */
+static std::atomic<bool> callDeferred { false };
+
+static PyObject* CallFrontendMethod(PyObject* self, PyObject* args)
+{
+    PyObject* future = JavaScript::InvokeFrontendMethodAsync(PLUGIN_NAME, "method", {}, std::chrono::seconds(10));
+    callDeferred = true;
+    return future;
+}
+
+static PyMethodDef callFrontendMethodDef = { "call_frontend_method", (PyCFunction)CallFrontendMethod, METH_NOARGS, NULL };
+
+/** What an IPC invoked backend method does to use the awaitable API from synchronous code. */
+static const char* AWAIT_FRONTEND_CALL = R"(
+import asyncio
+
+async def await_frontend_call():
+    try:
+        await call_frontend_method()
+    except ConnectionError:
+        return "ConnectionError"
+    except TimeoutError:
+        return "TimeoutError"
+    return "resolved"
+
+result = asyncio.run(await_frontend_call())
+)";
+
+/**
+ * IPC calls run on the plugin's executor, so a loop started by one keeps the executor busy until it returns.
+ * The result of a frontend call awaited on that loop has to reach it without waiting in the executor's queue.
+ */
+static void TestAwaitOnExecutor()
+{
+    auto executor = std::make_shared<PluginExecutor>(PLUGIN_NAME, PyInterpreterState_Main());
+    executor->Start();
+
+    std::promise<std::string> result;
+    executor->Post([&result] 
+    {
+        PyObject* globals = PyDict_New();
+        PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+
+        PyObject* function = PyCFunction_New(&callFrontendMethodDef, NULL);
+        PyDict_SetItemString(globals, "call_frontend_method", function);
+        Py_DECREF(function);
+
+        PyObject* ran = PyRun_String(AWAIT_FRONTEND_CALL, Py_file_input, globals, globals);
+        if (ran == NULL) 
+        {
+            PyErr_Print();
+        }
+        Py_XDECREF(ran);
+
+        PyObject* value = PyDict_GetItemString(globals, "result");
+        result.set_value(value != NULL && PyUnicode_Check(value) ? PyUnicode_AsUTF8(value) : "");
+        Py_DECREF(globals);
+    });
+
+    while (!callDeferred.load()) 
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    /** Nothing is connected, so starting the deferred call fails it with a ConnectionError, delivered from this thread. */
+    const auto started = std::chrono::steady_clock::now();
+    JavaScript::MarkFrontendReady(PLUGIN_NAME);
+
+    CHECK_EQ(result.get_future().get(), std::string("ConnectionError"));
+    CHECK(std::chrono::steady_clock::now() - started < std::chrono::seconds(5));
+
+    executor->Stop();
+}
+
+int main()
+{
+    Py_Initialize();
+    PyThreadState* mainThreadState = PyEval_SaveThread();
+
+    TestAwaitOnExecutor();
+
+    PyEval_RestoreThread(mainThreadState);
+    Py_Finalize();
+    return TEST_RESULT();
+}
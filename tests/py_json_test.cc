@@ -0,0 +1,235 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <Python.h>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "ffi.h"
+#include "test_helpers.h"
+
+/**
+ * @brief Evaluate a Python expression in a shared namespace, `setup` runs first (i.e to build a value in several statements).
+ * @returns {PyObject*} - A new reference, the test is aborted if Python raises.
+ */
+static PyObject* Evaluate(const std::string& setup, const char* expression)
+{
+    static PyObject* globals = []
+    {
+        PyObject* dict = PyDict_New();
+        PyDict_SetItemString(dict, "__builtins__", PyEval_GetBuiltins());
+        return dict;
+    }();
+
+    PyObject* result = PyRun_String(setup.c_str(), Py_file_input, globals, globals);
+    Py_XDECREF(result);
+
+    PyObject* value = PyRun_String(expression, Py_eval_input, globals, globals);
+    if (value == NULL) 
+    {
+        PyErr_Print();
+        std::abort();
+    }
+    return value;
+}
+
+/** What the json module makes of a value, the reference both converters are checked against. */
+static nlohmann::json DumpWithJsonModule(PyObject* object)
+{
+    PyObject* jsonModule = PyImport_ImportModule("json");
+    PyObject* encoded = PyObject_CallMethod(jsonModule, "dumps", "O", object);
+
+    nlohmann::json value = nlohmann::json::parse(PyUnicode_AsUTF8(encoded));
+
+    Py_DECREF(encoded);
+    Py_DECREF(jsonModule);
+    return value;
+}
+
+/** Converts to JSON and back, checking the JSON against json.dumps and the round trip against the original value. */
+static void CheckRoundTrip(PyObject* object)
+{
+    nlohmann::json value;
+
+    CHECK(Python::PyObjectToJson(object, value));
+    CHECK(PyErr_Occurred() == NULL);
+    CHECK_EQ(value, DumpWithJsonModule(object));
+
+    PyObject* converted = Python::JsonToPyObject(value);
+
+    CHECK(converted != NULL);
+    CHECK(converted != NULL && PyObject_RichCompareBool(converted, object, Py_EQ) == 1);
+
+    Py_XDECREF(converted);
+    PyErr_Clear();
+}
+
+/** Checks that PyObjectToJson refuses a value with the given exception type set, and doesn't leave anything behind. */
+static void CheckRefused(PyObject* object, PyObject* exceptionType)
+{
+    nlohmann::json value;
+
+    CHECK(!Python::PyObjectToJson(object, value));
+    CHECK(PyErr_ExceptionMatches(exceptionType));
+    PyErr_Clear();
+}
+
+static void TestScalars()
+{
+    PyObject* scalars = Evaluate("", "[None, True, False, 0, -1, 1.5, '', 'caf\\u00e9 \\U0001F600', '\\x00']");
+    CheckRoundTrip(scalars);
+    Py_DECREF(scalars);
+
+    PyObject* bytes = Evaluate("", "b'\\x00\\xffbinary'");
+    nlohmann::json value;
+
+    CHECK(Python::PyObjectToJson(bytes, value));
+    CHECK(value.is_binary());
+
+    PyObject* converted = Python::JsonToPyObject(value);
+    CHECK(converted != NULL && PyObject_RichCompareBool(converted, bytes, Py_EQ) == 1);
+
+    Py_XDECREF(converted);
+    Py_DECREF(bytes);
+}
+
+static void TestLargePayload()
+{
+    PyObject* payload = Evaluate(
+        "count = 100000", 
+        "[{ 'id': i, 'name': 'plugin-%d' % i, 'tags': ['theme', 'store'], 'score': i * 0.5, 'enabled': i % 2 == 0, 'parent': None } for i in range(count)]"
+    );
+    CheckRoundTrip(payload);
+    Py_DECREF(payload);
+
+    PyObject* longString = Evaluate("", "'x' * (16 * 1024 * 1024)");
+    CheckRoundTrip(longString);
+    Py_DECREF(longString);
+}
+
+/** The root is depth 0, so a value with MAX_JSON_DEPTH levels of nesting below it is the deepest one accepted. */
+static void TestDeepNesting()
+{
+    const std::string depth = std::to_string(Python::MAX_JSON_DEPTH);
+
+    PyObject* deepest = Evaluate("nested = 'leaf'\nfor _ in range(" + depth + "): nested = [nested] if _ % 2 else { 'next': nested }", "nested");
+    CheckRoundTrip(deepest);
+
+    PyObject* tooDeep = Evaluate("", "[nested]");
+    CheckRefused(tooDeep, PyExc_RecursionError);
+
+    nlohmann::json value = "leaf";
+    for (int i = 0; i <= Python::MAX_JSON_DEPTH; i++) 
+    {
+        value = nlohmann::json::array({ std::move(value) });
+    }
+
+    CHECK(Python::JsonToPyObject(value) == NULL);
+    CHECK(PyErr_ExceptionMatches(PyExc_RecursionError));
+    PyErr_Clear();
+
+    Py_DECREF(tooDeep);
+    Py_DECREF(deepest);
+}
+
+static void TestReferenceCycles()
+{
+    PyObject* cyclicList = Evaluate("cycle = []\ncycle.append(cycle)", "cycle");
+    CheckRefused(cyclicList, PyExc_RecursionError);
+    Py_DECREF(cyclicList);
+
+    PyObject* cyclicDict = Evaluate("cycle = {}\ncycle['self'] = [cycle]", "cycle");
+    CheckRefused(cyclicDict, PyExc_RecursionError);
+    Py_DECREF(cyclicDict);
+}
+
+/** Keys follow json.dumps, str, int, float, bool and None are accepted, anything else is a TypeError. */
+static void TestDictKeys()
+{
+    PyObject* keys = Evaluate("", "{ 'name': 0, 3: 1, -2: 2, 2.5: 3, True: 4, None: 5, 10**30: 6 }");
+    nlohmann::json value;
+
+    CHECK(Python::PyObjectToJson(keys, value));
+    CHECK_EQ(value, DumpWithJsonModule(keys));
+    CHECK(value.contains("3") && value.contains("-2") && value.contains("2.5") && value.contains("true") && value.contains("null"));
+    Py_DECREF(keys);
+
+    PyObject* tupleKey = Evaluate("", "{ (1, 2): 'tuple' }");
+    CheckRefused(tupleKey, PyExc_TypeError);
+    Py_DECREF(tupleKey);
+
+    PyObject* unserializable = Evaluate("", "{ 'value': object() }");
+    CheckRefused(unserializable, PyExc_TypeError);
+    Py_DECREF(unserializable);
+}
+
+/** Integers keep their exact value as long as they fit in 64 bits (signed or unsigned), wider ones become floats. */
+static void TestIntegers()
+{
+    PyObject* exact = Evaluate("", "[2**63 - 1, -2**63, 2**64 - 1, 2**63]");
+    nlohmann::json value;
+
+    CHECK(Python::PyObjectToJson(exact, value));
+    CHECK(value[0].is_number_integer() && value[0].get<int64_t>() == INT64_MAX);
+    CHECK(value[1].is_number_integer() && value[1].get<int64_t>() == INT64_MIN);
+    CHECK(value[2].is_number_unsigned() && value[2].get<uint64_t>() == UINT64_MAX);
+    CHECK(value[3].is_number_unsigned() && value[3].get<uint64_t>() == (1ULL << 63));
+
+    PyObject* converted = Python::JsonToPyObject(value);
+    CHECK(converted != NULL && PyObject_RichCompareBool(converted, exact, Py_EQ) == 1);
+    Py_XDECREF(converted);
+    Py_DECREF(exact);
+
+    PyObject* wide = Evaluate("", "[2**64, -2**63 - 1]");
+    CHECK(Python::PyObjectToJson(wide, value));
+    CHECK(value[0].is_number_float() && value[0].get<double>() == 18446744073709551616.0);
+    CHECK(value[1].is_number_float() && value[1].get<double>() == -9223372036854775809.0);
+    Py_DECREF(wide);
+
+    /** Out of range for a double as well. */
+    PyObject* huge = Evaluate("", "10**400");
+    CheckRefused(huge, PyExc_OverflowError);
+    Py_DECREF(huge);
+}
+
+int main()
+{
+    Py_Initialize();
+
+    TestScalars();
+    TestLargePayload();
+    TestDeepNesting();
+    TestReferenceCycles();
+    TestDictKeys();
+    TestIntegers();
+
+    Py_Finalize();
+    return TEST_RESULT();
+}
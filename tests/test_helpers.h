@@ -0,0 +1,65 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdio>
+#include <string>
+
+/**
+ * Minimal assertions for the native unit tests, every test is a plain executable registered with ctest.
+ * Failed checks are printed with their location and counted, main() returns the count so ctest sees the failure.
+ */
+namespace TestHelpers
+{
+    static inline int& FailureCount()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    static inline void ReportFailure(const char* file, int line, const std::string& message)
+    {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, message.c_str());
+        FailureCount()++;
+    }
+}
+
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) TestHelpers::ReportFailure(__FILE__, __LINE__, #condition);     \
+    } while (false)
+
+#define CHECK_EQ(actual, expected)                                                        \
+    do {                                                                                  \
+        if (!((actual) == (expected))) TestHelpers::ReportFailure(__FILE__, __LINE__, #actual " == " #expected); \
+    } while (false)
+
+#define TEST_RESULT() (TestHelpers::FailureCount() == 0 ? 0 : 1)
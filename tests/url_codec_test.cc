@@ -0,0 +1,118 @@
+/**
+ * ==================================================
+ *   _____ _ _ _             _                     
+ *  |     |_| | |___ ___ ___|_|_ _ _____           
+ *  | | | | | | | -_|   |   | | | |     |          
+ *  |_|_|_|_|_|_|___|_|_|_|_|_|___|_|_|_|          
+ * 
+ * ==================================================
+ * 
+ * Copyright (c) 2025 Project Millennium
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string>
+#include "url_parser.h"
+#include "test_helpers.h"
+
+static void TestEmptyInput()
+{
+    CHECK_EQ(UrlEncode(""), "");
+    CHECK_EQ(UrlDecode(""), "");
+
+    std::string output = "prefix";
+    UrlEncodeInto("", output);
+    UrlDecodeInto("", output);
+    CHECK_EQ(output, "prefix");
+}
+
+static void TestUnreservedCharacters()
+{
+    const std::string unreserved = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.~/";
+
+    CHECK_EQ(UrlEncode(unreserved), unreserved);
+    CHECK_EQ(UrlDecode(unreserved), unreserved);
+}
+
+static void TestReservedCharacters()
+{
+    CHECK_EQ(UrlEncode(" "), "+");
+    CHECK_EQ(UrlEncode("a b&c=d?e#f%g+h"), "a+b%26c%3Dd%3Fe%23f%25g%2Bh");
+    CHECK_EQ(UrlEncode("(Dark)"), "%28Dark%29");
+    CHECK_EQ(UrlEncode(std::string("\0\n\x7F", 3)), "%00%0A%7F");
+    CHECK_EQ(UrlEncode("\xC3\xA9"), "%C3%A9");
+
+    CHECK_EQ(UrlDecode("a+b%26c%3Dd%3Fe%23f%25g%2Bh"), "a b&c=d?e#f%g+h");
+    CHECK_EQ(UrlDecode("%c3%a9"), "\xC3\xA9");
+    CHECK_EQ(UrlDecode("%00"), std::string("\0", 1));
+}
+
+/** A '%' that isn't followed by two hex digits is kept as is, nothing after it is dropped. */
+static void TestInvalidEscapes()
+{
+    CHECK_EQ(UrlDecode("%"), "%");
+    CHECK_EQ(UrlDecode("%4"), "%4");
+    CHECK_EQ(UrlDecode("100%"), "100%");
+    CHECK_EQ(UrlDecode("%zz"), "%zz");
+    CHECK_EQ(UrlDecode("%4g+"), "%4g ");
+    CHECK_EQ(UrlDecode("%%41"), "%A");
+    CHECK_EQ(UrlDecode("a%41"), "aA");
+}
+
+static void TestRoundTrip()
+{
+    std::string everyByte;
+    for (int c = 0; c < 256; c++) 
+    {
+        everyByte.push_back(static_cast<char>(c));
+    }
+
+    CHECK_EQ(UrlDecode(UrlEncode(everyByte)), everyByte);
+    CHECK_EQ(UrlDecode(UrlEncode("home/user/plugins/Fluenty (Dark) \xC3\xA9" "dition/library & store.css")), "home/user/plugins/Fluenty (Dark) \xC3\xA9" "dition/library & store.css");
+
+    /** The Into variants append to what is already in the sink. */
+    std::string output = "https://millennium.ftp/";
+    UrlEncodeInto("a b", output);
+    CHECK_EQ(output, "https://millennium.ftp/a+b");
+
+    std::string decoded = "/";
+    UrlDecodeInto("a+b%2F", decoded);
+    CHECK_EQ(decoded, "/a b/");
+
+    #if defined(__linux__) || defined(__APPLE__)
+    {
+        const std::string path = "/home/user/plugins/library & store.css";
+        CHECK_EQ(UrlFromPath("https://millennium.ftp/", path), "https://millennium.ftp/home/user/plugins/library+%26+store.css");
+        CHECK_EQ(PathFromUrl("home/user/plugins/library+%26+store.css"), path);
+    }
+    #endif
+}
+
+int main()
+{
+    TestEmptyInput();
+    TestUnreservedCharacters();
+    TestReservedCharacters();
+    TestInvalidEscapes();
+    TestRoundTrip();
+
+    return TEST_RESULT();
+}